@@ -4,20 +4,31 @@
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include "backoff.hpp"
+#include "cas_stats.hpp"
+#include "latency_histogram.hpp"
 
 // Demonstrating CAS with and without backoff
 // Backoff = adding deliberate delays between failed CAS retries to reduce cache line contention
 
 std::atomic<int> counter_no_backoff{0};
 std::atomic<int> counter_with_backoff{0};
-std::atomic<int> failed_cas_count_no_backoff{0};
-std::atomic<int> failed_cas_count_with_backoff{0};
 
 const int ITERATIONS = 100000;
 const int NUM_THREADS = 4;
 
+// Failed CAS attempts are counted per thread (see cas_stats.hpp) and merged
+// after join(), so the instrumentation doesn't add a contended line of its own
+CasStats stats_no_backoff(NUM_THREADS);
+CasStats stats_with_backoff(NUM_THREADS);
+
 // CAS without backoff (naive)
-void worker_no_backoff() {
+void worker_no_backoff(CasCounters& stats) {
     for (int i = 0; i < ITERATIONS; ++i) {
         int old = counter_no_backoff.load(std::memory_order_relaxed);
         while (!counter_no_backoff.compare_exchange_weak(
@@ -25,37 +36,208 @@ void worker_no_backoff() {
             std::memory_order_relaxed,
             std::memory_order_relaxed)) {
             // Immediate retry - hammers the cache line
-            failed_cas_count_no_backoff.fetch_add(1, std::memory_order_relaxed);
+            stats.on_failure();
+        }
+        stats.on_success();
+    }
+}
+
+// The old instrumentation: one shared atomic bumped inside the retry loop.
+// Kept only to show how much it perturbs the measurement.
+std::atomic<int> counter_shared_instrumented{0};
+std::atomic<long> failed_cas_count_shared{0};
+
+void worker_no_backoff_shared_counter() {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        int old = counter_shared_instrumented.load(std::memory_order_relaxed);
+        while (!counter_shared_instrumented.compare_exchange_weak(
+            old, old + 1,
+            std::memory_order_relaxed,
+            std::memory_order_relaxed)) {
+            failed_cas_count_shared.fetch_add(1, std::memory_order_relaxed);
         }
     }
 }
 
 // CAS with exponential backoff
-void worker_with_backoff() {
+void worker_with_backoff(CasCounters& stats) {
     for (int i = 0; i < ITERATIONS; ++i) {
         int old = counter_with_backoff.load(std::memory_order_relaxed);
-        int backoff = 1;
+        ExponentialBackoff<1, 64> backoff;
         while (!counter_with_backoff.compare_exchange_weak(
             old, old + 1,
             std::memory_order_relaxed,
             std::memory_order_relaxed)) {
             // Backoff strategy: pause briefly, then increase delay
-            for (int j = 0; j < backoff; ++j) {
-                #if defined(_MSC_VER)
-                    _mm_pause();  // x86 intrinsic
-                #elif defined(__GNUC__) || defined(__clang__)
-                    __builtin_ia32_pause();  // GCC/Clang intrinsic
-                #else
-                    std::this_thread::yield();
-                #endif
+            backoff.pause();  // Exponential backoff, cap at 64 (see backoff.hpp)
+            stats.on_failure();
+        }
+        stats.on_success();
+    }
+}
+
+// ============ SWEEP MODE (--sweep) ============
+// Sweeps backoff cap x growth factor x thread count on this host and reports
+// throughput, failed-CAS ratio and per-operation tail latency, then picks the
+// best configuration per thread count.
+
+const int SWEEP_ITERATIONS = 20000;
+const int SWEEP_CAPS[] = {1, 4, 16, 64, 256, 1024, 4096};
+const int SWEEP_GROWTH[] = {2, 4, 8};
+const int SWEEP_THREADS[] = {1, 2, 4, 8, 16};
+
+std::atomic<int> counter_sweep{0};
+
+// One pause in TSC cycles: ~10 on older Intel, ~140 on Skylake-SP and later.
+// This is what makes "cap = 64 pauses" mean very different delays per CPU.
+double measure_pause_cycles() {
+    const int N = 100000;
+    double best = 1e30;
+    for (int rep = 0; rep < 5; ++rep) {
+        uint64_t t0 = read_tsc();
+        cpu_relax(N);
+        uint64_t t1 = read_tsc();
+        best = std::min(best, static_cast<double>(t1 - t0) / N);
+    }
+    return best;
+}
+
+// TSC ticks per nanosecond, so per-op cycle counts can be reported as ns
+double measure_tsc_per_ns() {
+    auto c0 = std::chrono::steady_clock::now();
+    uint64_t t0 = read_tsc();
+    while (std::chrono::steady_clock::now() - c0 < std::chrono::milliseconds(20)) {}
+    uint64_t t1 = read_tsc();
+    auto c1 = std::chrono::steady_clock::now();
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(c1 - c0).count());
+    return static_cast<double>(t1 - t0) / ns;
+}
+
+void worker_sweep(int cap, int growth, CasCounters& stats, LatencyHistogram& latencies) {
+    for (int i = 0; i < SWEEP_ITERATIONS; ++i) {
+        uint64_t t0 = read_tsc();
+        int old = counter_sweep.load(std::memory_order_relaxed);
+        TunableBackoff backoff(1, cap, growth);
+        while (!counter_sweep.compare_exchange_weak(
+            old, old + 1,
+            std::memory_order_relaxed,
+            std::memory_order_relaxed)) {
+            backoff.pause();
+            stats.on_failure();
+        }
+        stats.on_success();
+        uint64_t t1 = read_tsc();
+        latencies.record(t1 - t0);
+    }
+}
+
+struct SweepResult {
+    int threads;
+    int cap;
+    int growth;
+    double mops;
+    double failure_ratio;
+    double p50_ns;
+    double p99_ns;
+    double p999_ns;
+};
+
+SweepResult run_sweep_point(int num_threads, int cap, int growth, double tsc_per_ns) {
+    counter_sweep.store(0);
+    CasStats stats(num_threads);
+    LatencyHistogram latencies;  // Shared: each thread records into its own stripe
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(worker_sweep, cap, growth,
+                             std::ref(stats.slot(i)), std::ref(latencies));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
+    // Percentiles in TSC ticks, merged across the per-thread stripes
+    const HistogramSnapshot snap = latencies.snapshot();
+    auto percentile = [&](double p) { return snap.percentile(p * 100) / tsc_per_ns; };
+
+    SweepResult r;
+    r.threads = num_threads;
+    r.cap = cap;
+    r.growth = growth;
+    r.mops = us > 0 ? static_cast<double>(num_threads) * SWEEP_ITERATIONS / us : 0.0;
+    r.failure_ratio = stats.failure_ratio();
+    r.p50_ns = percentile(0.50);
+    r.p99_ns = percentile(0.99);
+    r.p999_ns = percentile(0.999);
+    return r;
+}
+
+int run_sweep() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  CAS Backoff Parameter Sweep                       ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    double tsc_per_ns = measure_tsc_per_ns();
+    double pause_cycles = measure_pause_cycles();
+    std::cout << "Host calibration:\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  TSC: " << tsc_per_ns << " ticks/ns\n";
+    std::cout << "  pause: " << pause_cycles << " TSC cycles ("
+              << pause_cycles / tsc_per_ns << " ns)\n";
+    std::cout << "  Iterations per thread: " << SWEEP_ITERATIONS << "\n\n";
+
+    std::cout << "┌─────────┬───────┬────────┬───────────┬───────────┬──────────┬──────────┬───────────┐\n";
+    std::cout << "│ Threads │ Cap   │ Growth │ Mops/s    │ Fail rate │ p50 ns   │ p99 ns   │ p99.9 ns  │\n";
+    std::cout << "├─────────┼───────┼────────┼───────────┼───────────┼──────────┼──────────┼───────────┤\n";
+
+    std::vector<SweepResult> best;
+    for (int n : SWEEP_THREADS) {
+        SweepResult winner{};
+        for (int cap : SWEEP_CAPS) {
+            for (int growth : SWEEP_GROWTH) {
+                if (cap == 1 && growth != SWEEP_GROWTH[0])
+                    continue;  // Cap 1 never grows: one row is enough
+                SweepResult r = run_sweep_point(n, cap, growth, tsc_per_ns);
+                std::cout << "│ " << std::setw(7) << n << " │ "
+                          << std::setw(5) << cap << " │ "
+                          << std::setw(6) << growth << " │ "
+                          << std::setw(9) << r.mops << " │ "
+                          << std::setw(9) << std::setprecision(4) << r.failure_ratio << " │ "
+                          << std::setw(8) << std::setprecision(0) << r.p50_ns << " │ "
+                          << std::setw(8) << r.p99_ns << " │ "
+                          << std::setw(9) << r.p999_ns << " │\n"
+                          << std::setprecision(2);
+                if (r.mops > winner.mops)
+                    winner = r;
             }
-            backoff = std::min(backoff * 2, 64);  // Exponential backoff, cap at 64
-            failed_cas_count_with_backoff.fetch_add(1, std::memory_order_relaxed);
         }
+        best.push_back(winner);
+    }
+    std::cout << "└─────────┴───────┴────────┴───────────┴───────────┴──────────┴──────────┴───────────┘\n\n";
+
+    std::cout << "Optimal configuration per thread count (by throughput):\n";
+    for (const auto& r : best) {
+        std::cout << "  " << std::setw(2) << r.threads << " threads → cap " << r.cap
+                  << ", growth x" << r.growth << "  (" << r.mops << " Mops/s, p99 "
+                  << std::setprecision(0) << r.p99_ns << " ns, cap ≈ "
+                  << r.cap * pause_cycles / tsc_per_ns << " ns)\n"
+                  << std::setprecision(2);
     }
+    std::cout << "\nA cap in pauses only means something together with the pause length:\n";
+    std::cout << "compare caps across machines in ns (cap × pause), not in pauses.\n";
+    return 0;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--sweep") == 0) {
+        return run_sweep();
+    }
+    
     std::cout << "╔════════════════════════════════════════════════════╗\n";
     std::cout << "║  CAS with Backoff: Reducing Cache Line Contention  ║\n";
     std::cout << "╚════════════════════════════════════════════════════╝\n\n";
@@ -67,12 +249,12 @@ int main() {
     // Test 1: No backoff
     std::cout << "Running CAS WITHOUT backoff...\n";
     counter_no_backoff.store(0);
-    failed_cas_count_no_backoff.store(0);
+    stats_no_backoff.reset();
     
     auto start1 = std::chrono::high_resolution_clock::now();
     std::vector<std::thread> threads1;
     for (int i = 0; i < NUM_THREADS; ++i) {
-        threads1.emplace_back(worker_no_backoff);
+        threads1.emplace_back(worker_no_backoff, std::ref(stats_no_backoff.slot(i)));
     }
     for (auto& t : threads1) {
         t.join();
@@ -81,14 +263,14 @@ int main() {
     auto duration1 = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1);
     
     // Test 2: With backoff
-    std::cout << "Running CAS WITH backoff...\n\n";
+    std::cout << "Running CAS WITH backoff...\n";
     counter_with_backoff.store(0);
-    failed_cas_count_with_backoff.store(0);
+    stats_with_backoff.reset();
     
     auto start2 = std::chrono::high_resolution_clock::now();
     std::vector<std::thread> threads2;
     for (int i = 0; i < NUM_THREADS; ++i) {
-        threads2.emplace_back(worker_with_backoff);
+        threads2.emplace_back(worker_with_backoff, std::ref(stats_with_backoff.slot(i)));
     }
     for (auto& t : threads2) {
         t.join();
@@ -96,6 +278,23 @@ int main() {
     auto end2 = std::chrono::high_resolution_clock::now();
     auto duration2 = std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2);
     
+    
+    // Test 3: No backoff, instrumented the old way (shared atomic counter)
+    std::cout << "Running CAS WITHOUT backoff, shared-atomic instrumentation...\n\n";
+    counter_shared_instrumented.store(0);
+    failed_cas_count_shared.store(0);
+    
+    auto start3 = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads3;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads3.emplace_back(worker_no_backoff_shared_counter);
+    }
+    for (auto& t : threads3) {
+        t.join();
+    }
+    auto end3 = std::chrono::high_resolution_clock::now();
+    auto duration3 = std::chrono::duration_cast<std::chrono::milliseconds>(end3 - start3);
+    
     // Results
     std::cout << "┌────────────────────┬─────────────┬──────────────┬─────────────────┐\n";
     std::cout << "│ Strategy           │ Time (ms)   │ Final Count  │ Failed CAS      │\n";
@@ -103,13 +302,30 @@ int main() {
     std::cout << "│ No Backoff         │ " 
               << std::setw(11) << duration1.count() << " │ "
               << std::setw(12) << counter_no_backoff.load() << " │ "
-              << std::setw(15) << failed_cas_count_no_backoff.load() << " │\n";
+              << std::setw(15) << stats_no_backoff.failures() << " │\n";
     std::cout << "│ With Backoff       │ " 
               << std::setw(11) << duration2.count() << " │ "
               << std::setw(12) << counter_with_backoff.load() << " │ "
-              << std::setw(15) << failed_cas_count_with_backoff.load() << " │\n";
+              << std::setw(15) << stats_with_backoff.failures() << " │\n";
+    std::cout << "│ No Backoff (shared)│ " 
+              << std::setw(11) << duration3.count() << " │ "
+              << std::setw(12) << counter_shared_instrumented.load() << " │ "
+              << std::setw(15) << failed_cas_count_shared.load() << " │\n";
     std::cout << "└────────────────────┴─────────────┴──────────────┴─────────────────┘\n\n";
     
+    if (!CasStats::enabled) {
+        std::cout << "(Per-thread CAS stats compiled out: CAS_STATS_ENABLED=0)\n\n";
+    }
+    
+    std::cout << "Failed-CAS ratio: no backoff "
+              << std::fixed << std::setprecision(4) << stats_no_backoff.failure_ratio()
+              << ", with backoff " << stats_with_backoff.failure_ratio() << "\n\n";
+    
+    std::cout << "Instrumentation check:\n";
+    std::cout << "• Per-thread counters: padded to a cache line, merged after join()\n";
+    std::cout << "• Shared atomic counter: a second contended line inside the retry loop\n";
+    std::cout << "  → compare 'No Backoff' with 'No Backoff (shared)' to see the distortion\n\n";
+    
     std::cout << "Key Observations:\n";
     std::cout << "• Without backoff: Immediate retries hammer the cache line\n";
     std::cout << "  → More contention, more coherence traffic\n";
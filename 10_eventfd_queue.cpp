@@ -0,0 +1,263 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+// eventfd bridge: letting a lock-free queue sit in an epoll set
+// The 07-style `ready` flag only works for a thread that is willing to spin.
+// An I/O thread sleeps in epoll_wait, so the queue needs a file descriptor -
+// but one write() per message would cost more than the queue itself.
+
+#if defined(__linux__)
+
+const int MESSAGES = 500'000;
+const size_t QUEUE_CAPACITY = 1024;  // Power of two
+
+// When does the producer pay for a write() on the eventfd?
+enum class NotifyPolicy {
+    EveryPush,        // Naive: one syscall per message
+    EmptyTransition,  // Only when the queue goes from empty to non-empty
+    Interest          // Only when a consumer has registered interest (is about to sleep)
+};
+
+// Bounded single-producer / single-consumer ring (lock-free, no CAS needed)
+template <typename T>
+class SpscQueue {
+private:
+    alignas(64) std::atomic<size_t> head{0};  // Next slot to read (consumer owned)
+    alignas(64) std::atomic<size_t> tail{0};  // Next slot to write (producer owned)
+    alignas(64) T slots[QUEUE_CAPACITY];
+
+public:
+    bool push(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == QUEUE_CAPACITY)
+            return false;  // Full
+        slots[t & (QUEUE_CAPACITY - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);  // Publish the slot
+        return true;
+    }
+
+    bool pop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;  // Empty
+        value = slots[h & (QUEUE_CAPACITY - 1)];
+        head.store(h + 1, std::memory_order_release);  // Hand the slot back
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+// Optional notifier attached to a queue: owns the eventfd and decides
+// whether a push has to make a syscall.
+class EventfdNotifier {
+private:
+    int fd;
+    NotifyPolicy policy;
+    alignas(64) std::atomic<long> pending{0};       // EmptyTransition: items not yet consumed
+    alignas(64) std::atomic<bool> waiting{false};   // Interest: consumer is about to sleep
+
+public:
+    std::atomic<long> writes{0};  // Syscall accounting (touched only on the slow path)
+
+    explicit EventfdNotifier(NotifyPolicy p)
+        : fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), policy(p) {}
+    ~EventfdNotifier() { close(fd); }
+
+    int native_handle() const { return fd; }
+
+    // Producer side: call after the item has been published
+    void after_push() {
+        switch (policy) {
+        case NotifyPolicy::EveryPush:
+            signal();
+            break;
+        case NotifyPolicy::EmptyTransition:
+            // fetch_add returns 0 only if the consumer already accounted for
+            // every earlier item, i.e. it has decided the queue is empty.
+            if (pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+                signal();
+            break;
+        case NotifyPolicy::Interest:
+            // Pairs with the fence in prepare_wait(): either we see the flag,
+            // or the consumer's re-check sees our item. Never both missed.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_relaxed) &&
+                waiting.exchange(false, std::memory_order_relaxed))
+                signal();
+            break;
+        }
+    }
+
+    // Consumer side (EmptyTransition): call after each pop.
+    // Returns true when this was the last outstanding item.
+    bool after_pop() {
+        return pending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    // Consumer side (Interest): register interest, then re-check the queue.
+    // Returns false if the caller must NOT sleep (an item raced in).
+    template <typename Queue>
+    bool prepare_wait(const Queue& q) {
+        waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!q.empty()) {
+            waiting.store(false, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    // Consumer side: reset the eventfd counter after epoll reports it readable
+    void consume() {
+        uint64_t count;
+        ssize_t n = read(fd, &count, sizeof(count));
+        (void)n;  // EAGAIN is fine: a stale wakeup already drained it
+    }
+
+private:
+    void signal() {
+        uint64_t one = 1;
+        ssize_t n = write(fd, &one, sizeof(one));
+        (void)n;
+        writes.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+struct BenchResult {
+    long long elapsed_us;
+    long writes;
+    long reads;
+    long epoll_waits;
+    long long checksum;
+};
+
+BenchResult run_benchmark(NotifyPolicy policy) {
+    SpscQueue<int> queue;
+    EventfdNotifier notifier(policy);
+    long reads = 0;
+    long epoll_waits = 0;
+    long long checksum = 0;
+
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;  // Level-triggered
+    ev.data.fd = notifier.native_handle();
+    epoll_ctl(epfd, EPOLL_CTL_ADD, notifier.native_handle(), &ev);
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread consumer([&] {
+        int received = 0;
+        int value;
+        epoll_event events[1];
+        while (received < MESSAGES) {
+            // Sleep like a real I/O thread would
+            if (policy == NotifyPolicy::Interest && !notifier.prepare_wait(queue)) {
+                // Item raced in while registering interest - don't sleep
+            } else {
+                epoll_wait(epfd, events, 1, -1);
+                ++epoll_waits;
+                notifier.consume();
+                ++reads;
+            }
+            // Drain everything that is available
+            while (queue.pop(value)) {
+                checksum += value;
+                ++received;
+                if (policy == NotifyPolicy::EmptyTransition && notifier.after_pop())
+                    break;  // Last outstanding item: the next push will signal
+            }
+        }
+    });
+
+    for (int i = 0; i < MESSAGES; ++i) {
+        while (!queue.push(i)) {
+            std::this_thread::yield();  // Full: let the consumer catch up
+        }
+        notifier.after_push();
+    }
+    consumer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    close(epfd);
+
+    return {std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+            notifier.writes.load(), reads, epoll_waits, checksum};
+}
+
+void print_row(const char* name, const BenchResult& r) {
+    double seconds = r.elapsed_us / 1e6;
+    double syscalls = static_cast<double>(r.writes + r.reads + r.epoll_waits);
+    std::cout << "│ " << std::left << std::setw(19) << name << std::right << "│ "
+              << std::setw(11) << r.elapsed_us / 1000 << " │ "
+              << std::setw(12) << std::fixed << std::setprecision(0)
+              << (seconds > 0 ? MESSAGES / seconds : 0.0) << " │ "
+              << std::setw(10) << r.writes << " │ "
+              << std::setw(12) << std::setprecision(4) << syscalls / MESSAGES << " │\n";
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  eventfd Bridge: Lock-Free Queue + epoll           ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Messages: " << MESSAGES << "\n";
+    std::cout << "  Queue capacity: " << QUEUE_CAPACITY << "\n";
+    std::cout << "  1 producer, 1 consumer sleeping in epoll_wait\n\n";
+
+    std::cout << "Running benchmarks...\n\n";
+    BenchResult every = run_benchmark(NotifyPolicy::EveryPush);
+    BenchResult transition = run_benchmark(NotifyPolicy::EmptyTransition);
+    BenchResult interest = run_benchmark(NotifyPolicy::Interest);
+
+    const long long expected = static_cast<long long>(MESSAGES) * (MESSAGES - 1) / 2;
+    bool ok = every.checksum == expected && transition.checksum == expected &&
+              interest.checksum == expected;
+
+    std::cout << "┌────────────────────┬─────────────┬──────────────┬────────────┬──────────────┐\n";
+    std::cout << "│ Notify Policy      │ Time (ms)   │ Messages/s   │ write()s   │ Syscalls/msg │\n";
+    std::cout << "├────────────────────┼─────────────┼──────────────┼────────────┼──────────────┤\n";
+    print_row("Every push", every);
+    print_row("Empty to non-empty", transition);
+    print_row("Consumer interest", interest);
+    std::cout << "└────────────────────┴─────────────┴──────────────┴────────────┴──────────────┘\n\n";
+    std::cout << "All messages delivered: " << (ok ? "yes ✅" : "NO ❌") << "\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Signaling every push turns a ~10 ns enqueue into a ~1 µs syscall\n";
+    std::cout << "• Empty→non-empty: one write() per burst, but a shared counter RMW per message\n";
+    std::cout << "• Consumer interest: no shared RMW, just a load of the 'waiting' flag\n";
+    std::cout << "  → seq_cst fences on both sides close the lost-wakeup window\n";
+    std::cout << "• Once the consumer falls behind, syscalls/msg drops towards zero\n\n";
+
+    std::cout << "Lost-wakeup rule:\n";
+    std::cout << "  Consumer: set waiting → fence → re-check queue → sleep\n";
+    std::cout << "  Producer: publish item → fence → check waiting → signal\n";
+    std::cout << "  At least one side always sees the other's write.\n";
+
+    return ok ? 0 : 1;
+}
+
+#else
+
+int main() {
+    std::cout << "eventfd/epoll are Linux-only; this example is skipped on this platform.\n";
+    return 0;
+}
+
+#endif
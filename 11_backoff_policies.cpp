@@ -0,0 +1,112 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include "backoff.hpp"
+#include "cas_stats.hpp"
+
+// Backoff policies as template parameters
+// Same workload as 09_cas_with_backoff.cpp, but the retry strategy is a type:
+// the CAS loop is written once and instantiated per policy.
+
+const int ITERATIONS = 100000;
+const int THREAD_COUNTS[] = {2, 4, 8};
+
+std::atomic<int> counter{0};
+
+template <typename Backoff>
+void worker(CasCounters& stats) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        int old = counter.load(std::memory_order_relaxed);
+        Backoff backoff;
+        while (!counter.compare_exchange_weak(
+            old, old + 1,
+            std::memory_order_relaxed,
+            std::memory_order_relaxed)) {
+            backoff.pause();
+            stats.on_failure();
+        }
+        stats.on_success();
+    }
+}
+
+struct Result {
+    long long time_us;
+    int final_count;
+    long failed_cas;
+};
+
+template <typename Backoff>
+Result benchmark(int num_threads) {
+    counter.store(0);
+    CasStats stats(num_threads);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i)
+        threads.emplace_back(worker<Backoff>, std::ref(stats.slot(i)));
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return {std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+            counter.load(), stats.failures()};
+}
+
+template <typename Backoff>
+void print_row(const char* params, int num_threads, long long baseline_us) {
+    Result r = benchmark<Backoff>(num_threads);
+    std::cout << "│ " << std::left << std::setw(13) << Backoff::name
+              << std::setw(11) << params << std::right << "│ "
+              << std::setw(9) << r.time_us / 1000.0 << " │ "
+              << std::setw(9) << r.final_count << " │ "
+              << std::setw(10) << r.failed_cas << " │ "
+              << std::setw(7) << (r.time_us > 0 ? (double)baseline_us / r.time_us : 0.0)
+              << "x │\n";
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Backoff Policies: One CAS Loop, Many Strategies   ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Iterations per thread: " << ITERATIONS << "\n";
+    std::cout << "  Baseline: Exponential (1 → 64), the original 09 strategy\n\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (int num_threads : THREAD_COUNTS) {
+        // Warm up, then measure the current 09 policy as the baseline
+        benchmark<ExponentialBackoff<1, 64>>(num_threads);
+        long long baseline_us = benchmark<ExponentialBackoff<1, 64>>(num_threads).time_us;
+
+        std::cout << "Threads: " << num_threads << "\n";
+        std::cout << "┌─────────────────────────┬───────────┬───────────┬────────────┬──────────┐\n";
+        std::cout << "│ Policy                  │ Time (ms) │ Final     │ Failed CAS │ Speedup  │\n";
+        std::cout << "├─────────────────────────┼───────────┼───────────┼────────────┼──────────┤\n";
+        print_row<NoBackoff>("", num_threads, baseline_us);
+        print_row<ConstantBackoff<16>>("16", num_threads, baseline_us);
+        print_row<ExponentialBackoff<1, 64>>("1..64", num_threads, baseline_us);
+        print_row<ExponentialBackoff<1, 1024>>("1..1024", num_threads, baseline_us);
+        print_row<JitteredBackoff<1, 64>>("1..64", num_threads, baseline_us);
+        print_row<ProportionalBackoff<4, 256>>("4/fail", num_threads, baseline_us);
+        print_row<TscDeadlineBackoff<64, 4096>>("64..4096cy", num_threads, baseline_us);
+        std::cout << "└─────────────────────────┴───────────┴───────────┴────────────┴──────────┘\n\n";
+    }
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• NoBackoff compiles to the plain retry loop (empty pause())\n";
+    std::cout << "  → zero overhead when you don't want backoff\n";
+    std::cout << "• Jitter breaks up threads that failed together and would retry together\n";
+    std::cout << "• Proportional grows linearly: gentler than doubling, slower to back off\n";
+    std::cout << "• TSC deadline waits in cycles, not pauses\n";
+    std::cout << "  → `pause` latency varies ~10x between CPU generations\n\n";
+
+    std::cout << "Usage in any CAS loop:\n";
+    std::cout << "  cas_update<ExponentialBackoff<1, 64>>(counter, [](int v) { return v + 1; });\n";
+
+    return 0;
+}
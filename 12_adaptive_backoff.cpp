@@ -0,0 +1,138 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <string>
+#include "backoff.hpp"
+#include "cas_stats.hpp"
+
+// Self-tuning backoff vs the best static cap
+// The right cap depends on the machine and on how busy it is right now.
+// Here contention changes over time: workers alternate between BUSY rounds
+// (back-to-back CAS) and QUIET rounds (local work between CAS attempts).
+// A static cap is tuned for one of them; the adaptive one follows both.
+
+const int NUM_THREADS = 8;
+const int ROUNDS = 8;
+const int OPS_PER_ROUND = 10000;
+const int QUIET_WORK = 50;   // Pauses of local work per op in quiet rounds
+
+std::atomic<int> counter{0};
+std::atomic<long> final_cap_sum{0};
+CasStats stats(NUM_THREADS);
+
+template <typename Backoff>
+void worker(CasCounters& stats) {
+    for (int round = 0; round < ROUNDS; ++round) {
+        const bool quiet = (round % 2 == 1);
+        for (int i = 0; i < OPS_PER_ROUND; ++i) {
+            if (quiet)
+                cpu_relax(QUIET_WORK);  // Work that doesn't touch shared state
+            int old = counter.load(std::memory_order_relaxed);
+            Backoff backoff;
+            while (!counter.compare_exchange_weak(
+                old, old + 1,
+                std::memory_order_relaxed,
+                std::memory_order_relaxed)) {
+                backoff.pause();
+                stats.on_failure();
+            }
+            stats.on_success();
+        }
+    }
+}
+
+template <typename Backoff>
+long long benchmark() {
+    counter.store(0);
+    stats.reset();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i)
+        threads.emplace_back(worker<Backoff>, std::ref(stats.slot(i)));
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+// Adaptive run also reports where each thread's cap ended up
+void adaptive_worker(CasCounters& slot) {
+    worker<AdaptiveBackoff<>>(slot);
+    final_cap_sum.fetch_add(AdaptiveBackoff<>::state().cap, std::memory_order_relaxed);
+}
+
+long long benchmark_adaptive() {
+    counter.store(0);
+    stats.reset();
+    final_cap_sum.store(0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i)
+        threads.emplace_back(adaptive_worker, std::ref(stats.slot(i)));
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+void print_row(const char* name, long long time_us) {
+    std::cout << "│ " << std::left << std::setw(19) << name << std::right << "│ "
+              << std::setw(11) << std::fixed << std::setprecision(2) << time_us / 1000.0 << " │ "
+              << std::setw(12) << counter.load() << " │ "
+              << std::setw(15) << stats.failures() << " │\n";
+}
+
+template <int Cap>
+long long static_row(long long best) {
+    long long t = benchmark<ExponentialBackoff<1, Cap>>();
+    std::string name = "Static cap " + std::to_string(Cap);
+    print_row(name.c_str(), t);
+    return best < 0 || t < best ? t : best;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Adaptive Backoff: Tuning the Cap at Runtime       ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Threads: " << NUM_THREADS << "\n";
+    std::cout << "  Rounds: " << ROUNDS << " (busy / quiet alternating)\n";
+    std::cout << "  Ops per round per thread: " << OPS_PER_ROUND << "\n\n";
+
+    std::cout << "Running benchmarks...\n\n";
+    std::cout << "┌────────────────────┬─────────────┬──────────────┬─────────────────┐\n";
+    std::cout << "│ Strategy           │ Time (ms)   │ Final Count  │ Failed CAS      │\n";
+    std::cout << "├────────────────────┼─────────────┼──────────────┼─────────────────┤\n";
+    long long best = -1;
+    best = static_row<1>(best);
+    best = static_row<4>(best);
+    best = static_row<16>(best);
+    best = static_row<64>(best);
+    best = static_row<256>(best);
+    best = static_row<1024>(best);
+    best = static_row<4096>(best);
+    long long adaptive = benchmark_adaptive();
+    print_row("Adaptive", adaptive);
+    std::cout << "└────────────────────┴─────────────┴──────────────┴─────────────────┘\n\n";
+
+    std::cout << "Best static cap: " << best / 1000.0 << " ms\n";
+    std::cout << "Adaptive:        " << adaptive / 1000.0 << " ms ("
+              << std::setprecision(2) << (double)adaptive / best << "x of best static)\n";
+    std::cout << "Average final adaptive cap: "
+              << final_cap_sum.load() / NUM_THREADS << " pauses\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Each thread tracks its own failure ratio (EWMA) - no shared writes\n";
+    std::cout << "• Failures above the band → cap doubles; below → cap halves\n";
+    std::cout << "• The best static cap must be found by hand, per machine and per load\n";
+    std::cout << "  → adaptive gets close to it without tuning\n";
+
+    return 0;
+}
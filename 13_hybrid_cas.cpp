@@ -0,0 +1,226 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <string>
+#include "backoff.hpp"
+#include "cas_stats.hpp"
+
+// Hybrid CAS: lock-free while it pays, a fair queue lock when it doesn't
+// Under extreme contention every failed CAS is wasted coherence traffic.
+// The hybrid tries CAS with backoff a few times; after MaxFailures it
+// enqueues on an MCS lock, so the stragglers take turns instead of fighting.
+
+const int ITERATIONS = 20000;
+const int THREAD_COUNTS[] = {2, 4, 8, 16, 32, 64};
+
+// ============ MCS QUEUE LOCK ============
+// Each waiter spins on its OWN node, not on a shared word: one cache line
+// transfer per handoff, FIFO order (fair), no thundering herd.
+class McsLock {
+public:
+    struct alignas(64) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+
+    void lock(Node& me) {
+        me.next.store(nullptr, std::memory_order_relaxed);
+        me.locked.store(true, std::memory_order_relaxed);
+        Node* prev = tail.exchange(&me, std::memory_order_acq_rel);
+        if (prev != nullptr) {
+            prev->next.store(&me, std::memory_order_release);
+            int spins = 0;
+            while (me.locked.load(std::memory_order_acquire)) {
+                // Spin, then yield: the predecessor may have been preempted
+                if (++spins < 128) cpu_relax();
+                else std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock(Node& me) {
+        Node* succ = me.next.load(std::memory_order_acquire);
+        if (succ == nullptr) {
+            Node* expected = &me;
+            if (tail.compare_exchange_strong(expected, nullptr,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed))
+                return;  // No one queued behind us
+            // A successor swapped the tail but hasn't linked itself yet
+            while ((succ = me.next.load(std::memory_order_acquire)) == nullptr)
+                cpu_relax();
+        }
+        succ->locked.store(false, std::memory_order_release);
+    }
+
+private:
+    alignas(64) std::atomic<Node*> tail{nullptr};
+};
+
+// ============ HYBRID UPDATE PRIMITIVE ============
+template <typename Backoff = ExponentialBackoff<1, 64>, int MaxFailures = 8>
+class HybridCas {
+public:
+    alignas(64) std::atomic<int> value{0};
+
+    // value = fn(value); returns the replaced value
+    template <typename F>
+    int update(F fn, CasCounters& stats) {
+        // Phase 1: optimistic lock-free attempts
+        Backoff backoff;
+        int old = value.load(std::memory_order_relaxed);
+        for (int failures = 0; failures < MaxFailures; ++failures) {
+            if (value.compare_exchange_weak(old, fn(old),
+                                            std::memory_order_relaxed,
+                                            std::memory_order_relaxed)) {
+                stats.on_success();
+                return old;
+            }
+            stats.on_failure();
+            backoff.pause();
+        }
+
+        // Phase 2: escalate. Lock holders still CAS (fast-path threads never
+        // take the lock), but at most ONE straggler competes at a time.
+        McsLock::Node node;
+        lock.lock(node);
+        old = value.load(std::memory_order_relaxed);
+        while (!value.compare_exchange_weak(old, fn(old),
+                                            std::memory_order_relaxed,
+                                            std::memory_order_relaxed)) {
+            stats.on_failure();
+        }
+        stats.on_success();
+        lock.unlock(node);
+        return old;
+    }
+
+private:
+    McsLock lock;
+};
+
+// ============ WORKLOADS (worker_no_backoff from 09) ============
+std::atomic<int> counter_plain{0};
+std::atomic<int> counter_backoff{0};
+int counter_mcs = 0;
+McsLock mcs;
+HybridCas<> hybrid;
+
+void worker_no_backoff(CasCounters& stats) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        int old = counter_plain.load(std::memory_order_relaxed);
+        while (!counter_plain.compare_exchange_weak(
+            old, old + 1,
+            std::memory_order_relaxed,
+            std::memory_order_relaxed)) {
+            stats.on_failure();
+        }
+        stats.on_success();
+    }
+}
+
+void worker_with_backoff(CasCounters& stats) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        int old = counter_backoff.load(std::memory_order_relaxed);
+        ExponentialBackoff<1, 64> backoff;
+        while (!counter_backoff.compare_exchange_weak(
+            old, old + 1,
+            std::memory_order_relaxed,
+            std::memory_order_relaxed)) {
+            backoff.pause();
+            stats.on_failure();
+        }
+        stats.on_success();
+    }
+}
+
+void worker_mcs(CasCounters& stats) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        McsLock::Node node;
+        mcs.lock(node);
+        ++counter_mcs;
+        mcs.unlock(node);
+        stats.on_success();
+    }
+}
+
+void worker_hybrid(CasCounters& stats) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        hybrid.update([](int v) { return v + 1; }, stats);
+    }
+}
+
+struct Result {
+    long long time_us;
+    long failures;
+};
+
+Result benchmark(void (*worker)(CasCounters&), int num_threads) {
+    CasStats stats(num_threads);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i)
+        threads.emplace_back(worker, std::ref(stats.slot(i)));
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    return {std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+            stats.failures()};
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Hybrid CAS: Escalating to a Fair Queue Lock       ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Iterations per thread: " << ITERATIONS << "\n";
+    std::cout << "  Hybrid: exponential backoff, escalate after 8 failed CAS\n\n";
+
+    std::cout << "Time in ms (failed CAS in parentheses)\n";
+    std::cout << "┌─────────┬──────────────────┬──────────────────┬──────────────┬──────────────────┐\n";
+    std::cout << "│ Threads │ Plain CAS        │ CAS + backoff    │ MCS lock     │ Hybrid           │\n";
+    std::cout << "├─────────┼──────────────────┼──────────────────┼──────────────┼──────────────────┤\n";
+
+    bool ok = true;
+    for (int n : THREAD_COUNTS) {
+        counter_plain.store(0);
+        counter_backoff.store(0);
+        counter_mcs = 0;
+        hybrid.value.store(0);
+
+        Result plain = benchmark(worker_no_backoff, n);
+        Result backoff = benchmark(worker_with_backoff, n);
+        Result lock = benchmark(worker_mcs, n);
+        Result hyb = benchmark(worker_hybrid, n);
+
+        const int expected = n * ITERATIONS;
+        ok = ok && counter_plain.load() == expected && counter_backoff.load() == expected &&
+             counter_mcs == expected && hybrid.value.load() == expected;
+
+        auto cell = [](const Result& r) {
+            return std::to_string(r.time_us / 1000) + " (" +
+                   std::to_string(r.failures) + ")";
+        };
+        std::cout << "│ " << std::setw(7) << n << " │ "
+                  << std::setw(16) << cell(plain) << " │ "
+                  << std::setw(16) << cell(backoff) << " │ "
+                  << std::setw(12) << lock.time_us / 1000 << " │ "
+                  << std::setw(16) << cell(hyb) << " │\n";
+    }
+    std::cout << "└─────────┴──────────────────┴──────────────────┴──────────────┴──────────────────┘\n\n";
+    std::cout << "All counters correct: " << (ok ? "yes ✅" : "NO ❌") << "\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Low contention: the hybrid's first CAS succeeds → same cost as plain CAS\n";
+    std::cout << "• High contention: stragglers queue on the MCS lock in FIFO order\n";
+    std::cout << "  → one waiter at a time touches the hot line, like a pure lock\n";
+    std::cout << "• MCS waiters spin on their own node, so handoff is one cache-line transfer\n";
+    std::cout << "• Progress: the fast path stays lock-free; the slow path is blocking but fair\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,431 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include "epoch_reclaim.hpp"
+#include "zipf.hpp"
+
+// Lock-free split-ordered hash map (Shalev & Shavit)
+// All items live in ONE lock-free sorted linked list (Harris/Michael), sorted
+// by the bit-reversed hash. The bucket table only holds shortcuts ("dummy"
+// nodes) into that list. Doubling the table never moves an item: bucket b's
+// new sibling b + size starts exactly in the middle of b's run, so it is
+// created lazily by inserting one more dummy - no stop-the-world rehash.
+
+template <typename V>
+class SplitOrderedMap {
+    static_assert(std::is_trivially_copyable<V>::value, "values are stored in std::atomic<V>");
+
+private:
+    struct Node {
+        uint64_t so_key;                 // Split-order key (bit-reversed hash)
+        int key;
+        std::atomic<V> value;
+        std::atomic<uintptr_t> next{0};  // Low bit = "logically deleted" mark
+
+        Node(uint64_t so, int k, V v) : so_key(so), key(k), value(v) {}
+    };
+
+    static constexpr int SEGMENT_BITS = 10;
+    static constexpr size_t SEGMENT_SIZE = size_t(1) << SEGMENT_BITS;
+    static constexpr size_t MAX_SEGMENTS = 4096;  // Up to 4M buckets
+    static constexpr size_t MAX_BUCKETS = SEGMENT_SIZE * MAX_SEGMENTS;
+    static constexpr long LOAD_FACTOR = 2;         // Items per bucket before doubling
+
+    struct Segment {
+        std::atomic<Node*> slots[SEGMENT_SIZE];
+    };
+
+    std::atomic<Segment*> segments[MAX_SEGMENTS];
+    alignas(64) std::atomic<size_t> bucket_count{2};
+    alignas(64) std::atomic<long> item_count{0};
+    Node* head;  // Dummy for bucket 0, never removed
+
+    static Node* ptr(uintptr_t p) { return reinterpret_cast<Node*>(p & ~uintptr_t(1)); }
+    static bool marked(uintptr_t p) { return (p & 1) != 0; }
+
+    static uint64_t reverse_bits(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+        x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+        x = ((x >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((x & 0x0F0F0F0F0F0F0F0Full) << 4);
+        x = ((x >> 8) & 0x00FF00FF00FF00FFull) | ((x & 0x00FF00FF00FF00FFull) << 8);
+        x = ((x >> 16) & 0x0000FFFF0000FFFFull) | ((x & 0x0000FFFF0000FFFFull) << 16);
+        return (x >> 32) | (x << 32);
+    }
+
+    // 63-bit hash: the top bit is reserved to tell regular keys from dummies
+    static uint64_t hash(int key) {
+        uint64_t h = static_cast<uint32_t>(key);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h & ~(uint64_t(1) << 63);
+    }
+
+    static uint64_t so_regular(uint64_t h) { return reverse_bits(h | (uint64_t(1) << 63)); }  // Odd
+    static uint64_t so_dummy(size_t bucket) { return reverse_bits(bucket); }                   // Even
+
+    std::atomic<Node*>& bucket_slot(size_t b) {
+        const size_t s = b >> SEGMENT_BITS;
+        Segment* seg = segments[s].load(std::memory_order_acquire);
+        if (seg == nullptr) {
+            Segment* fresh = new Segment;
+            for (auto& slot : fresh->slots) slot.store(nullptr, std::memory_order_relaxed);
+            if (segments[s].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel))
+                seg = fresh;
+            else
+                delete fresh;  // Lost the race; `seg` now holds the winner
+        }
+        return seg->slots[b & (SEGMENT_SIZE - 1)];
+    }
+
+    // Harris/Michael search from `start`: positions `prev` (the link that
+    // points at `cur`) so that cur is the first node >= (so, key).
+    // Unlinks and retires marked nodes on the way. Caller holds an EpochGuard.
+    bool list_find(Node* start, uint64_t so, int key,
+                   std::atomic<uintptr_t>*& prev, Node*& cur) {
+    retry:
+        prev = &start->next;
+        cur = ptr(prev->load(std::memory_order_acquire));
+        while (cur != nullptr) {
+            uintptr_t next = cur->next.load(std::memory_order_acquire);
+            if (marked(next)) {
+                uintptr_t expected = reinterpret_cast<uintptr_t>(cur);
+                if (!prev->compare_exchange_strong(expected, next & ~uintptr_t(1),
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire))
+                    goto retry;
+                epoch_retire(cur);  // We unlinked it, we retire it (exactly once)
+                cur = ptr(next);
+                continue;
+            }
+            if (prev->load(std::memory_order_acquire) != reinterpret_cast<uintptr_t>(cur))
+                goto retry;  // prev got deleted or changed under us
+            if (cur->so_key > so || (cur->so_key == so && cur->key >= key))
+                return cur->so_key == so && cur->key == key;
+            prev = &cur->next;
+            cur = ptr(next);
+        }
+        return false;
+    }
+
+    // Link `node` in sorted position; returns the existing node if the key is taken
+    Node* list_insert(Node* start, Node* node) {
+        std::atomic<uintptr_t>* prev;
+        Node* cur;
+        while (true) {
+            if (list_find(start, node->so_key, node->key, prev, cur))
+                return cur;
+            node->next.store(reinterpret_cast<uintptr_t>(cur), std::memory_order_relaxed);
+            uintptr_t expected = reinterpret_cast<uintptr_t>(cur);
+            if (prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node),
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed))
+                return node;
+        }
+    }
+
+    // Recursive bucket initialization: a bucket's dummy is inserted starting
+    // from its parent's dummy (same index with the top bit cleared).
+    Node* get_bucket(size_t b) {
+        std::atomic<Node*>& slot = bucket_slot(b);
+        Node* dummy = slot.load(std::memory_order_acquire);
+        if (dummy != nullptr)
+            return dummy;
+
+        size_t msb = 1;
+        while ((msb << 1) <= b) msb <<= 1;
+        Node* parent_dummy = get_bucket(b - msb);  // b with its top set bit cleared
+
+        Node* fresh = new Node(so_dummy(b), 0, V{});
+        Node* winner = list_insert(parent_dummy, fresh);
+        if (winner != fresh)
+            delete fresh;  // Someone else initialized it first; ours was never published
+        slot.store(winner, std::memory_order_release);
+        return winner;
+    }
+
+public:
+    SplitOrderedMap() {
+        for (auto& s : segments) s.store(nullptr, std::memory_order_relaxed);
+        head = new Node(so_dummy(0), 0, V{});
+        bucket_slot(0).store(head, std::memory_order_relaxed);
+    }
+
+    ~SplitOrderedMap() {
+        // Single-threaded teardown: every node (live, dummy) is still on the list;
+        // removed nodes were handed to the epoch reclaimer.
+        Node* n = head;
+        while (n != nullptr) {
+            Node* next = ptr(n->next.load(std::memory_order_relaxed));
+            delete n;
+            n = next;
+        }
+        for (auto& s : segments) delete s.load(std::memory_order_relaxed);
+    }
+
+    bool insert(int key, V value) {
+        EpochGuard guard;
+        const uint64_t h = hash(key);
+        const size_t size = bucket_count.load(std::memory_order_acquire);
+        Node* bucket = get_bucket(h & (size - 1));
+        Node* node = new Node(so_regular(h), key, value);
+        if (list_insert(bucket, node) != node) {
+            delete node;  // Key already present; node never became visible
+            return false;
+        }
+        // Incremental resize: just publish a bigger bucket count. New buckets
+        // are filled in on first touch by get_bucket().
+        long items = item_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        size_t cur = size;
+        if (items / static_cast<long>(cur) > LOAD_FACTOR && cur * 2 <= MAX_BUCKETS)
+            bucket_count.compare_exchange_strong(cur, cur * 2, std::memory_order_acq_rel);
+        return true;
+    }
+
+    bool find(int key, V& out) {
+        EpochGuard guard;
+        const uint64_t h = hash(key);
+        Node* bucket = get_bucket(h & (bucket_count.load(std::memory_order_acquire) - 1));
+        std::atomic<uintptr_t>* prev;
+        Node* cur;
+        if (!list_find(bucket, so_regular(h), key, prev, cur))
+            return false;
+        out = cur->value.load(std::memory_order_acquire);
+        return true;
+    }
+
+    bool erase(int key) {
+        EpochGuard guard;
+        const uint64_t h = hash(key);
+        Node* bucket = get_bucket(h & (bucket_count.load(std::memory_order_acquire) - 1));
+        const uint64_t so = so_regular(h);
+        std::atomic<uintptr_t>* prev;
+        Node* cur;
+        while (true) {
+            if (!list_find(bucket, so, key, prev, cur))
+                return false;
+            uintptr_t next = cur->next.load(std::memory_order_acquire);
+            if (marked(next))
+                continue;  // Someone else is deleting it; find() will help
+            // 1. Logical delete: mark cur's next pointer
+            if (!cur->next.compare_exchange_weak(next, next | 1,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed))
+                continue;
+            item_count.fetch_sub(1, std::memory_order_relaxed);
+            // 2. Physical delete: unlink; if that races, a search cleans up
+            uintptr_t expected = reinterpret_cast<uintptr_t>(cur);
+            if (prev->compare_exchange_strong(expected, next,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed))
+                epoch_retire(cur);
+            else
+                list_find(bucket, so, key, prev, cur);
+            return true;
+        }
+    }
+
+    size_t buckets() const { return bucket_count.load(std::memory_order_relaxed); }
+    long size() const { return item_count.load(std::memory_order_relaxed); }
+};
+
+// ============ BASELINE: std::unordered_map + std::mutex ============
+template <typename V>
+class MutexMap {
+private:
+    std::mutex mtx;
+    std::unordered_map<int, V> map;
+
+public:
+    bool insert(int key, V value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        return map.emplace(key, value).second;
+    }
+
+    bool find(int key, V& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = map.find(key);
+        if (it == map.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    bool erase(int key) {
+        std::lock_guard<std::mutex> lock(mtx);
+        return map.erase(key) > 0;
+    }
+};
+
+// ============ BENCHMARK ============
+const int NUM_THREADS = 4;
+const int OPS_PER_THREAD = 200000;
+const int KEY_SPACE = 1 << 16;
+
+struct Mix {
+    const char* name;
+    int find_pct;
+    int insert_pct;  // Rest are erases
+};
+
+template <typename Map>
+void worker(Map& map, const Mix& mix, bool zipf, const ZipfGenerator& zipf_gen,
+            int seed, long& hits) {
+    FastRandom rng(seed);
+    long local_hits = 0;
+    long value;
+    for (int i = 0; i < OPS_PER_THREAD; ++i) {
+        int key = static_cast<int>(zipf ? zipf_gen.next(rng) : rng.next(KEY_SPACE));
+        int op = static_cast<int>(rng.next(100));
+        if (op < mix.find_pct)
+            local_hits += map.find(key, value);
+        else if (op < mix.find_pct + mix.insert_pct)
+            local_hits += map.insert(key, key);
+        else
+            local_hits += map.erase(key);
+    }
+    hits = local_hits;
+}
+
+template <typename Map>
+double benchmark(const Mix& mix, bool zipf, const ZipfGenerator& zipf_gen) {
+    Map map;
+    for (int k = 0; k < KEY_SPACE; k += 2)  // Prefill half the key space
+        map.insert(k, k);
+
+    std::vector<long> hits(NUM_THREADS);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i)
+        threads.emplace_back(worker<Map>, std::ref(map), std::cref(mix), zipf,
+                             std::cref(zipf_gen), i + 1, std::ref(hits[i]));
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    return static_cast<double>(NUM_THREADS) * OPS_PER_THREAD / us;  // Mops/s
+}
+
+// Single-threaded sanity check against std::unordered_map
+bool self_test() {
+    SplitOrderedMap<long> map;
+    std::unordered_map<int, long> ref;
+    FastRandom rng(42);
+    for (int i = 0; i < 200000; ++i) {
+        int key = static_cast<int>(rng.next(5000));
+        long v;
+        switch (rng.next(3)) {
+        case 0:
+            if (map.insert(key, key) != ref.emplace(key, key).second) return false;
+            break;
+        case 1:
+            if (map.erase(key) != (ref.erase(key) > 0)) return false;
+            break;
+        default:
+            if (map.find(key, v) != (ref.count(key) > 0)) return false;
+        }
+    }
+    return map.size() == static_cast<long>(ref.size());
+}
+
+// 4 threads on a fresh map, so bucket setup races too: each inserts its own
+// key range and erases the odd keys, and all of them insert/erase a shared
+// range at random. Every thread records its successful inserts minus erases
+// per key; those nets must add up to the final membership.
+bool concurrent_test() {
+    SplitOrderedMap<long> map;
+    const int threads = 4;
+    const int own = 20000;     // Keys per thread, disjoint
+    const int shared = 2000;   // Keys every thread fights over
+    const int base = threads * own;
+    std::vector<std::vector<int>> net(threads, std::vector<int>(shared, 0));
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            FastRandom rng(t + 11);
+            long v;
+            for (int i = 0; i < own; ++i) {
+                const int key = t * own + i;
+                if (!map.insert(key, key)) ok.store(false);
+                int s = static_cast<int>(rng.next(shared));
+                if (rng.next(2)) net[t][s] += map.insert(base + s, s);
+                else net[t][s] -= map.erase(base + s);
+                if (i % 2 == 1 && !map.erase(key)) ok.store(false);
+                if (map.find(key, v) != (i % 2 == 0)) ok.store(false);
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    long expected = threads * own / 2;
+    long v;
+    for (int key = 0; key < base; ++key)
+        if (map.find(key, v) != (key % 2 == 0)) return false;
+    for (int s = 0; s < shared; ++s) {
+        int in = 0;
+        for (int t = 0; t < threads; ++t) in += net[t][s];
+        if ((in != 0 && in != 1) || map.find(base + s, v) != (in == 1)) return false;
+        expected += in;
+    }
+    return ok.load() && map.size() == expected;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Lock-Free Split-Ordered Hash Map                  ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Self-test vs std::unordered_map: " << (self_test() ? "passed ✅" : "FAILED ❌") << "\n";
+    std::cout << "Concurrent insert/erase test: "
+              << (concurrent_test() ? "passed ✅" : "FAILED ❌") << "\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Threads: " << NUM_THREADS << "\n";
+    std::cout << "  Ops per thread: " << OPS_PER_THREAD << "\n";
+    std::cout << "  Key space: " << KEY_SPACE << " (half prefilled)\n\n";
+
+    ZipfGenerator zipf_gen(KEY_SPACE);
+    const Mix mixes[] = {
+        {"Lookups (100% find)", 100, 0},
+        {"Inserts + deletes", 0, 50},
+        {"Mixed 80/10/10", 80, 10},
+    };
+
+    std::cout << "Throughput in Mops/s\n";
+    std::cout << "┌──────────────────────┬─────────┬────────────────┬────────────────┬──────────┐\n";
+    std::cout << "│ Workload             │ Keys    │ mutex + umap   │ Split-ordered  │ Speedup  │\n";
+    std::cout << "├──────────────────────┼─────────┼────────────────┼────────────────┼──────────┤\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (const Mix& mix : mixes) {
+        for (bool zipf : {false, true}) {
+            double base = benchmark<MutexMap<long>>(mix, zipf, zipf_gen);
+            double lf = benchmark<SplitOrderedMap<long>>(mix, zipf, zipf_gen);
+            std::cout << "│ " << std::left << std::setw(21) << mix.name
+                      << "│ " << std::setw(8) << (zipf ? "Zipf" : "Uniform") << std::right
+                      << "│ " << std::setw(14) << base << " │ "
+                      << std::setw(14) << lf << " │ "
+                      << std::setw(7) << lf / base << "x │\n";
+        }
+    }
+    std::cout << "└──────────────────────┴─────────┴────────────────┴────────────────┴──────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Lookups never write shared memory except the thread's own epoch slot\n";
+    std::cout << "• Resizing = one CAS on the bucket count; buckets split lazily on first use\n";
+    std::cout << "• Removed nodes go to the epoch reclaimer, not `delete`\n";
+    std::cout << "  → no use-after-free for readers that still hold the pointer\n";
+    std::cout << "• Zipf keys hammer a few nodes; the mutex map serializes everything anyway\n";
+
+    return 0;
+}
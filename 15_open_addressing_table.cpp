@@ -0,0 +1,591 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include "backoff.hpp"
+#include "epoch_reclaim.hpp"
+#include "zipf.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Open-addressing concurrent hash table for integer keys
+// No nodes at all: each slot is ONE 64-bit atomic holding (key + 1, value).
+//   • insert claims an empty slot with a CAS, or CASes a new value in place
+//   • find is plain loads - no locks, no shared writes (only the reader's
+//     own epoch slot, which keeps a retired table array alive)
+//   • erase CASes the value to a tombstone; the key keeps its slot
+//   • resize: a new table is linked behind the full one and every write
+//     that meets it migrates at most HELP_CHUNKS chunks, freezing each slot
+//     so no update can be lost mid-copy, then carries on in the new table
+//     (moving its own key across first). Nobody waits for the migration.
+// Keys are uint32_t < UINT32_MAX, values are uint32_t < 0x7FFFFFFF.
+
+class AtomicSlotTable {
+private:
+    static constexpr uint64_t EMPTY = 0;
+    static constexpr uint32_t FROZEN = 0x80000000u;     // Value bit: slot is being migrated
+    static constexpr uint32_t TOMBSTONE = 0x7FFFFFFFu;  // Value: key was erased
+    static constexpr size_t MIGRATE_CHUNK = 1024;
+    static constexpr int HELP_CHUNKS = 2;  // Per operation that meets a migration
+
+    static uint64_t pack(uint32_t key, uint32_t value) {
+        return (static_cast<uint64_t>(key + 1) << 32) | value;
+    }
+    static uint32_t slot_key(uint64_t s) { return static_cast<uint32_t>(s >> 32) - 1; }
+    static uint32_t slot_value(uint64_t s) { return static_cast<uint32_t>(s) & ~FROZEN; }
+    static bool is_frozen(uint64_t s) { return (static_cast<uint32_t>(s) & FROZEN) != 0; }
+    static bool is_empty(uint64_t s) { return (s >> 32) == 0; }
+
+    struct Table {
+        const size_t capacity;  // Power of two
+        std::atomic<uint64_t>* slots;
+        std::atomic<Table*> next{nullptr};
+        alignas(64) std::atomic<long> claimed{0};  // Non-empty slots (incl. tombstones)
+        alignas(64) std::atomic<long> live{0};     // Keys with a real value
+        alignas(64) std::atomic<size_t> migrate_cursor{0};
+        alignas(64) std::atomic<size_t> migrated{0};
+
+        explicit Table(size_t cap) : capacity(cap), slots(new std::atomic<uint64_t>[cap]) {
+            for (size_t i = 0; i < cap; ++i) slots[i].store(EMPTY, std::memory_order_relaxed);
+        }
+        ~Table() { delete[] slots; }
+    };
+
+    alignas(64) std::atomic<Table*> current;
+
+    static size_t home(uint32_t key, size_t capacity) {
+        return (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull >> 20) & (capacity - 1);
+    }
+
+    // Copy a frozen key into the next table unless it already has a slot
+    // there: a writer that moved the key early may have updated or erased it
+    // since, and that newer slot wins. Copies are idempotent, so the chunk
+    // migrator and a writer's migrate_key() may both copy the same slot.
+    static void copy_into(Table* to, uint32_t key, uint32_t value) {
+        for (size_t i = home(key, to->capacity);; i = (i + 1) & (to->capacity - 1)) {
+            uint64_t s = to->slots[i].load(std::memory_order_acquire);
+            while (true) {
+                if (is_frozen(s))
+                    return;  // `to` is migrating too: its own sweep already has this key
+                if (is_empty(s)) {
+                    if (to->slots[i].compare_exchange_weak(s, pack(key, value),
+                                                           std::memory_order_acq_rel,
+                                                           std::memory_order_acquire)) {
+                        to->claimed.fetch_add(1, std::memory_order_relaxed);
+                        to->live.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    continue;  // Lost the race: re-examine what's there now
+                }
+                if (slot_key(s) == key)
+                    return;
+                break;  // Someone else's key: probe on
+            }
+        }
+    }
+
+    // Freeze slot i of `from` (no more writes land there) and copy it forward
+    static void migrate_slot(Table* from, size_t i, Table* to) {
+        uint64_t s = from->slots[i].load(std::memory_order_relaxed);
+        while (!is_frozen(s) && !from->slots[i].compare_exchange_weak(s, s | FROZEN,
+                                                                      std::memory_order_acq_rel,
+                                                                      std::memory_order_relaxed)) {
+        }
+        if (!is_empty(s) && slot_value(s) != TOMBSTONE)
+            copy_into(to, slot_key(s), slot_value(s));
+    }
+
+    void start_resize(Table* t) {
+        if (t->next.load(std::memory_order_acquire) != nullptr ||
+            current.load(std::memory_order_acquire) != t)
+            return;  // One migration at a time: `t` must be the live table
+        // Mostly tombstones → same size (just cleans them up); otherwise double
+        long live = t->live.load(std::memory_order_relaxed);
+        size_t cap = live >= static_cast<long>(t->capacity / 4) ? t->capacity * 2 : t->capacity;
+        Table* fresh = new Table(cap);
+        Table* expected = nullptr;
+        if (!t->next.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+            delete fresh;  // Another writer started it first
+    }
+
+    void finish(Table* t, Table* to) {
+        Table* expected = t;
+        if (current.compare_exchange_strong(expected, to, std::memory_order_acq_rel))
+            epoch_retire(t);  // Readers may still be probing it
+    }
+
+    // Each operation that meets a migration copies at most HELP_CHUNKS
+    // chunks and moves on; whoever completes the last chunk retires `t`.
+    // Nobody waits for the other migrators.
+    void help_migrate(Table* t) {
+        Table* to = t->next.load(std::memory_order_acquire);
+        for (int c = 0; c < HELP_CHUNKS; ++c) {
+            size_t begin = t->migrate_cursor.fetch_add(MIGRATE_CHUNK, std::memory_order_relaxed);
+            if (begin >= t->capacity)
+                return;
+            size_t end = std::min(begin + MIGRATE_CHUNK, t->capacity);
+            for (size_t i = begin; i < end; ++i) migrate_slot(t, i, to);
+            if (t->migrated.fetch_add(end - begin, std::memory_order_acq_rel) + (end - begin) ==
+                t->capacity)
+                finish(t, to);
+        }
+    }
+
+    // The successor is filling up before `t` has drained (a migrator holding
+    // a chunk was preempted): sweep all of `t` ourselves rather than wait
+    void migrate_all(Table* t) {
+        Table* to = t->next.load(std::memory_order_acquire);
+        for (size_t i = 0; i < t->capacity; ++i) migrate_slot(t, i, to);
+        finish(t, to);
+    }
+
+    // Frozen-slot fallback: before a writer touches `key` in the new table,
+    // freeze the key's slot in `t` and copy it - or, if `t` has no slot for
+    // it, freeze the empty slot that ends its probe chain, so a writer still
+    // working in `t` can't add the key there behind our back.
+    static void migrate_key(Table* t, uint32_t key) {
+        Table* to = t->next.load(std::memory_order_acquire);
+        const size_t mask = t->capacity - 1;
+        size_t i = home(key, t->capacity);
+        for (size_t probes = 0; probes < t->capacity; ++probes, i = (i + 1) & mask) {
+            uint64_t s = t->slots[i].load(std::memory_order_acquire);
+            while (is_empty(s) && !is_frozen(s) &&
+                   !t->slots[i].compare_exchange_weak(s, s | FROZEN, std::memory_order_acq_rel,
+                                                      std::memory_order_acquire)) {
+            }
+            if (is_empty(s))
+                return;  // Frozen empty: the key was never in `t`
+            if (slot_key(s) == key) {
+                migrate_slot(t, i, to);
+                return;
+            }
+        }
+    }
+
+    // Table a write of `key` must go to: the newest one, after helping the
+    // migration along and moving `key` out of the table being drained
+    Table* writable(uint32_t key) {
+        Table* t = current.load(std::memory_order_acquire);
+        while (Table* to = t->next.load(std::memory_order_acquire)) {
+            help_migrate(t);
+            migrate_key(t, key);
+            t = to;
+        }
+        return t;
+    }
+
+    // Lookup in `t` and, if it was frozen, in its successor. Loads only.
+    // Returns 1 = live value, 0 = erased (tombstone), -1 = key has no slot.
+    static int find_in(Table* t, uint32_t key, uint32_t& out) {
+        const size_t mask = t->capacity - 1;
+        size_t i = home(key, t->capacity);
+        for (size_t probes = 0; probes < t->capacity; ++probes, i = (i + 1) & mask) {
+            uint64_t s = t->slots[i].load(std::memory_order_acquire);
+            if (is_empty(s)) {
+                if (is_frozen(s))
+                    break;  // May have been inserted after migration → look in next
+                return -1;
+            }
+            if (slot_key(s) != key)
+                continue;
+            if (is_frozen(s)) {
+                // If the key has a slot in the new table, that one is
+                // authoritative; if not, nobody has written it since the freeze.
+                int r = find_in(t->next.load(std::memory_order_acquire), key, out);
+                if (r != -1)
+                    return r;
+            }
+            out = slot_value(s);
+            return out != TOMBSTONE ? 1 : 0;
+        }
+        Table* to = t->next.load(std::memory_order_acquire);
+        return to != nullptr ? find_in(to, key, out) : -1;
+    }
+
+public:
+    explicit AtomicSlotTable(size_t initial_capacity = 1024)
+        : current(new Table(initial_capacity)) {}
+
+    ~AtomicSlotTable() {
+        Table* t = current.load(std::memory_order_relaxed);
+        while (t) {
+            Table* n = t->next.load(std::memory_order_relaxed);
+            delete t;
+            t = n;
+        }
+    }
+
+    bool find(uint32_t key, uint32_t& out) {
+        EpochGuard guard;  // Only protects the table array from being freed
+        return find_in(current.load(std::memory_order_acquire), key, out) == 1;
+    }
+
+    // Insert or overwrite; returns true if the key was not present before
+    bool insert(uint32_t key, uint32_t value) {
+        EpochGuard guard;
+        while (true) {
+            Table* t = writable(key);
+            Table* live = current.load(std::memory_order_acquire);
+            const long claimed = t->claimed.load(std::memory_order_relaxed);
+            if (live == t && claimed * 4 >= static_cast<long>(t->capacity) * 3) {
+                start_resize(t);  // Past 3/4 full
+                continue;
+            }
+            // Still draining the previous table into `t`: bounded help keeps
+            // far ahead of inserts unless a migrator stalls mid-chunk. Past
+            // half full, finish the drain ourselves - `t` must keep room for
+            // every key still to be copied (at most 3/4 of a half-size table,
+            // or 1/4 of a same-size one).
+            if (live != t && claimed * 2 >= static_cast<long>(t->capacity) &&
+                live->next.load(std::memory_order_acquire) == t) {
+                migrate_all(live);
+                continue;
+            }
+            const size_t mask = t->capacity - 1;
+            size_t i = home(key, t->capacity);
+            bool retry = false;
+            for (size_t probes = 0; probes < t->capacity && !retry; ++probes, i = (i + 1) & mask) {
+                uint64_t s = t->slots[i].load(std::memory_order_acquire);
+                while (true) {
+                    if (is_frozen(s)) {
+                        retry = true;  // Migration started under us
+                        break;
+                    }
+                    if (is_empty(s)) {
+                        // Claim the slot for this key
+                        if (t->slots[i].compare_exchange_weak(s, pack(key, value),
+                                                              std::memory_order_acq_rel,
+                                                              std::memory_order_acquire)) {
+                            t->claimed.fetch_add(1, std::memory_order_relaxed);
+                            t->live.fetch_add(1, std::memory_order_relaxed);
+                            return true;
+                        }
+                        continue;  // Lost the race: re-examine what's there now
+                    }
+                    if (slot_key(s) != key)
+                        break;  // Someone else's key: probe on
+                    const bool was_absent = slot_value(s) == TOMBSTONE;
+                    if (t->slots[i].compare_exchange_weak(s, pack(key, value),
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_acquire)) {
+                        if (was_absent) t->live.fetch_add(1, std::memory_order_relaxed);
+                        return was_absent;
+                    }
+                }
+            }
+            if (retry)
+                continue;
+            start_resize(t);  // Probed the whole table
+        }
+    }
+
+    bool erase(uint32_t key) {
+        EpochGuard guard;
+        while (true) {
+            Table* t = writable(key);
+            const size_t mask = t->capacity - 1;
+            size_t i = home(key, t->capacity);
+            bool retry = false;
+            for (size_t probes = 0; probes < t->capacity && !retry; ++probes, i = (i + 1) & mask) {
+                uint64_t s = t->slots[i].load(std::memory_order_acquire);
+                while (true) {
+                    if (is_frozen(s)) {
+                        retry = true;
+                        break;
+                    }
+                    if (is_empty(s))
+                        return false;
+                    if (slot_key(s) != key)
+                        break;
+                    if (slot_value(s) == TOMBSTONE)
+                        return false;
+                    if (t->slots[i].compare_exchange_weak(s, pack(key, TOMBSTONE),
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_acquire)) {
+                        t->live.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+            }
+            if (!retry)
+                return false;
+        }
+    }
+
+    size_t capacity() { return current.load(std::memory_order_acquire)->capacity; }
+};
+
+// ============ BASELINE: striped-lock std::unordered_map ============
+class StripedMap {
+private:
+    static constexpr int STRIPES = 64;
+    struct alignas(64) Stripe {
+        std::mutex mtx;
+        std::unordered_map<uint32_t, uint32_t> map;
+    };
+    Stripe stripes[STRIPES];
+
+    Stripe& stripe(uint32_t key) { return stripes[(key * 0x9E3779B1u) >> 26]; }
+
+public:
+    bool find(uint32_t key, uint32_t& out) {
+        Stripe& s = stripe(key);
+        std::lock_guard<std::mutex> lock(s.mtx);
+        auto it = s.map.find(key);
+        if (it == s.map.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    bool insert(uint32_t key, uint32_t value) {
+        Stripe& s = stripe(key);
+        std::lock_guard<std::mutex> lock(s.mtx);
+        auto r = s.map.insert_or_assign(key, value);
+        return r.second;
+    }
+
+    bool erase(uint32_t key) {
+        Stripe& s = stripe(key);
+        std::lock_guard<std::mutex> lock(s.mtx);
+        return s.map.erase(key) > 0;
+    }
+};
+
+// ============ CACHE-MISS COUNTER (Linux perf_event) ============
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter() {
+#if defined(__linux__)
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#if defined(__linux__)
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+// ============ BENCHMARK ============
+const int NUM_THREADS = 4;
+const int OPS_PER_THREAD = 500000;
+const uint32_t KEY_SPACE = 1 << 20;  // Large enough to spill out of L2
+const int FIND_PCT = 90;             // Rest split between insert and erase
+
+template <typename Map>
+void prefill(Map& map) {
+    for (uint32_t k = 0; k < KEY_SPACE; k += 2)
+        map.insert(k, k);
+}
+
+template <typename Map>
+void worker(Map& map, int seed) {
+    FastRandom rng(seed);
+    uint32_t value;
+    for (int i = 0; i < OPS_PER_THREAD; ++i) {
+        uint32_t key = static_cast<uint32_t>(rng.next(KEY_SPACE));
+        int op = static_cast<int>(rng.next(100));
+        if (op < FIND_PCT)
+            map.find(key, value);
+        else if (op % 2 == 0)
+            map.insert(key, key);
+        else
+            map.erase(key);
+    }
+}
+
+template <typename Map>
+double throughput(Map& map) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i)
+        threads.emplace_back(worker<Map>, std::ref(map), i + 1);
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    return static_cast<double>(NUM_THREADS) * OPS_PER_THREAD / us;
+}
+
+// Single-threaded lookups of random keys: cache misses and ns per lookup.
+// Returns the number of hits, so both maps can be checked against each other.
+template <typename Map>
+long lookup_cost(Map& map, double& ns_per_lookup, double& misses_per_lookup) {
+    const int LOOKUPS = 1000000;
+    FastRandom rng(99);
+    CacheMissCounter counter;
+    uint32_t value;
+    long hits = 0;
+    counter.start();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < LOOKUPS; ++i)
+        hits += map.find(static_cast<uint32_t>(rng.next(KEY_SPACE)), value);
+    auto end = std::chrono::high_resolution_clock::now();
+    long long misses = counter.stop();
+    ns_per_lookup = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / LOOKUPS;
+    misses_per_lookup = misses >= 0 ? static_cast<double>(misses) / LOOKUPS : -1.0;
+    return hits;
+}
+
+bool self_test() {
+    AtomicSlotTable table(16);  // Tiny: forces several resizes
+    std::unordered_map<uint32_t, uint32_t> ref;
+    FastRandom rng(7);
+    for (int i = 0; i < 300000; ++i) {
+        uint32_t key = static_cast<uint32_t>(rng.next(20000));  // Migrations span many ops
+        uint32_t v;
+        switch (rng.next(3)) {
+        case 0: {
+            bool fresh = ref.find(key) == ref.end();
+            ref[key] = i & 0xFFFF;
+            if (table.insert(key, i & 0xFFFF) != fresh) return false;
+            break;
+        }
+        case 1:
+            if (table.erase(key) != (ref.erase(key) > 0)) return false;
+            break;
+        default: {
+            auto it = ref.find(key);
+            bool found = table.find(key, v);
+            if (found != (it != ref.end()) || (found && v != it->second)) return false;
+        }
+        }
+    }
+    return true;
+}
+
+// Writers on disjoint keys race through every resize from 16 slots up;
+// each must still see its own writes, and nothing may be lost or revived
+bool concurrent_test() {
+    AtomicSlotTable table(16);
+    const int threads = 4;
+    const uint32_t per_thread = 50000;
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            uint32_t v;
+            for (uint32_t i = 0; i < per_thread; ++i) {
+                const uint32_t key = i * threads + t;
+                table.insert(key, i);
+                if (!table.find(key, v) || v != i) ok.store(false);
+                if (i % 2 == 1 && !table.erase(key - threads)) ok.store(false);  // Previous key
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    uint32_t v;
+    for (uint32_t key = 0; key < per_thread * threads; ++key) {
+        const uint32_t i = key / threads;
+        const bool expect = i % 2 == 1 || i == per_thread - 1;
+        if (table.find(key, v) != expect || (expect && v != i)) return false;
+    }
+    return ok.load();
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Open-Addressing Table with Atomic Slots           ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Self-test (with resizes) vs std::unordered_map: "
+              << (self_test() ? "passed ✅" : "FAILED ❌") << "\n";
+    std::cout << "Concurrent inserts/erases through resizes (4 threads): "
+              << (concurrent_test() ? "passed ✅" : "FAILED ❌") << "\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Threads: " << NUM_THREADS << "\n";
+    std::cout << "  Ops per thread: " << OPS_PER_THREAD << " (" << FIND_PCT
+              << "% find, rest insert/erase)\n";
+    std::cout << "  Key space: " << KEY_SPACE << " (half prefilled)\n\n";
+
+    AtomicSlotTable table;
+    StripedMap striped;
+    prefill(table);
+    prefill(striped);
+
+    double ns_table, miss_table, ns_striped, miss_striped;
+    long hits_table = lookup_cost(table, ns_table, miss_table);
+    long hits_striped = lookup_cost(striped, ns_striped, miss_striped);
+    double mops_table = throughput(table);
+    double mops_striped = throughput(striped);
+
+    auto misses = [](double m) {
+        if (m < 0) return std::string("n/a");
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(2) << m;
+        return os.str();
+    };
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "┌──────────────────────────┬────────────┬────────────────┬────────────┐\n";
+    std::cout << "│ Structure                │ ns/lookup  │ Misses/lookup  │ Mops/s     │\n";
+    std::cout << "├──────────────────────────┼────────────┼────────────────┼────────────┤\n";
+    std::cout << "│ Striped mutex + umap     │ " << std::setw(10) << ns_striped << " │ "
+              << std::setw(14) << misses(miss_striped) << " │ "
+              << std::setw(10) << mops_striped << " │\n";
+    std::cout << "│ Atomic-slot table        │ " << std::setw(10) << ns_table << " │ "
+              << std::setw(14) << misses(miss_table) << " │ "
+              << std::setw(10) << mops_table << " │\n";
+    std::cout << "└──────────────────────────┴────────────┴────────────────┴────────────┘\n";
+    std::cout << "Lookup hits: " << hits_table << " (table) vs " << hits_striped << " (striped) "
+              << (hits_table == hits_striped ? "✅" : "❌") << "\n";
+    std::cout << "Final table capacity: " << table.capacity() << " slots\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• A lookup is a hash + a few adjacent 8-byte loads: usually one cache line\n";
+    std::cout << "• Node-based maps chase bucket → node pointers: extra misses per lookup\n";
+    std::cout << "• Lookups never write, so readers don't bounce cache lines between cores\n";
+    std::cout << "• Tombstones keep probe chains intact; resizes clean them up\n";
+    std::cout << "• Misses need perf_event access (n/a in containers without it)\n";
+
+    return 0;
+}
@@ -0,0 +1,551 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <shared_mutex>
+#include <mutex>
+#include <new>
+#include <climits>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include "epoch_reclaim.hpp"
+#include "zipf.hpp"
+
+// Lock-free ordered skiplist map (Herlihy & Shavit / Fraser)
+// Every level is a Harris-style list with MARKED next pointers:
+//   1. erase marks the node's next pointers top-down (logical delete)
+//   2. any traversal that meets a marked node snips it out with a CAS
+//   3. once unlinked at every level, the node goes to the epoch reclaimer
+// find / lower_bound / range scans only read: they step over marked nodes
+// instead of snipping them. Range iteration is weakly consistent: it sees
+// every key present for the whole scan, and may or may not see concurrent
+// inserts and erases.
+// erase() never waits for an inserter still linking upper levels: it marks
+// the node at once. The inserter links each level with a CAS on the node's
+// own next pointer, so it sees the mark, stops, and leaves the snipping to
+// find(). Whichever of the two finishes last snips and retires the node.
+
+template <typename V>
+class LockFreeSkipList {
+    static_assert(std::is_trivially_copyable<V>::value, "values are stored in std::atomic<V>");
+
+public:
+    static constexpr int MAX_LEVEL = 20;
+
+private:
+    struct Node {
+        int key;
+        std::atomic<V> value;
+        int height;
+        std::atomic<int> done{0};         // LINKED | ERASED, last one retires
+        std::atomic<uintptr_t> next[1];   // Really `height` entries (allocated below)
+
+        Node(int k, V v, int h) : key(k), value(v), height(h) {}
+    };
+
+    static Node* create(int key, V value, int height) {
+        void* mem = ::operator new(sizeof(Node) + (height - 1) * sizeof(std::atomic<uintptr_t>));
+        Node* n = new (mem) Node(key, value, height);
+        for (int i = 1; i < height; ++i)
+            new (&n->next[i]) std::atomic<uintptr_t>(0);
+        n->next[0].store(0, std::memory_order_relaxed);
+        return n;
+    }
+
+    static void destroy(void* p) {
+        Node* n = static_cast<Node*>(p);
+        n->~Node();
+        ::operator delete(p);
+    }
+
+    static Node* ptr(uintptr_t p) { return reinterpret_cast<Node*>(p & ~uintptr_t(1)); }
+    static bool marked(uintptr_t p) { return (p & 1) != 0; }
+    static uintptr_t raw(Node* n) { return reinterpret_cast<uintptr_t>(n); }
+
+    static constexpr int LINKED = 1;  // Inserter stopped linking upper levels
+    static constexpr int ERASED = 2;  // Eraser marked every level
+
+    // Inserter and eraser each call this once; a node never erased just
+    // collects LINKED. The second caller sees all of the first one's links
+    // and marks, so its find() snips the node from every level it reached,
+    // and nobody links it again.
+    void release(Node* node, int who) {
+        if (node->done.fetch_or(who, std::memory_order_acq_rel) == 0)
+            return;
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        find(node->key, preds, succs);
+        EpochReclaimer::instance().retire(node, destroy);
+    }
+
+    Node* head;
+
+    static int random_level() {
+        thread_local FastRandom rng(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        int level = 1;
+        uint64_t bits = rng.next();
+        while ((bits & 1) && level < MAX_LEVEL) {  // p = 1/2 per level
+            ++level;
+            bits >>= 1;
+        }
+        return level;
+    }
+
+    // Positions preds/succs around `key` on every level, snipping marked
+    // nodes on the way. Returns true if an unmarked node with `key` exists.
+    bool find(int key, Node** preds, Node** succs) {
+    retry:
+        Node* pred = head;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            Node* curr = ptr(pred->next[level].load(std::memory_order_acquire));
+            while (curr != nullptr) {
+                uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+                if (marked(succ)) {
+                    uintptr_t expected = raw(curr);
+                    if (!pred->next[level].compare_exchange_strong(expected, succ & ~uintptr_t(1),
+                                                                   std::memory_order_acq_rel,
+                                                                   std::memory_order_acquire))
+                        goto retry;  // pred changed or got marked itself
+                    curr = ptr(succ);
+                    continue;
+                }
+                if (curr->key >= key)
+                    break;
+                pred = curr;
+                curr = ptr(succ);
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return succs[0] != nullptr && succs[0]->key == key;
+    }
+
+    // Read-only search for the first unmarked node with key >= `key`
+    Node* seek(int key) const {
+        Node* pred = head;
+        Node* curr = nullptr;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            curr = ptr(pred->next[level].load(std::memory_order_acquire));
+            while (curr != nullptr) {
+                uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+                if (marked(succ)) {
+                    curr = ptr(succ);  // Step over, don't snip
+                    continue;
+                }
+                if (curr->key >= key)
+                    break;
+                pred = curr;
+                curr = ptr(succ);
+            }
+        }
+        return curr;
+    }
+
+    static Node* next_live(Node* n) {
+        while (n != nullptr && marked(n->next[0].load(std::memory_order_acquire)))
+            n = ptr(n->next[0].load(std::memory_order_acquire));
+        return n;
+    }
+
+public:
+    LockFreeSkipList() : head(create(INT_MIN, V{}, MAX_LEVEL)) {}
+
+    ~LockFreeSkipList() {
+        Node* n = head;
+        while (n != nullptr) {
+            Node* next = ptr(n->next[0].load(std::memory_order_relaxed));
+            destroy(n);
+            n = next;
+        }
+    }
+
+    bool insert(int key, V value) {
+        EpochGuard guard;
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        const int height = random_level();
+        Node* node = nullptr;
+        while (true) {
+            if (find(key, preds, succs)) {
+                if (node) destroy(node);  // Never published
+                return false;
+            }
+            if (!node) node = create(key, value, height);
+            for (int i = 0; i < height; ++i)
+                node->next[i].store(raw(succs[i]), std::memory_order_relaxed);
+            // Linearization point: linking level 0
+            uintptr_t expected = raw(succs[0]);
+            if (preds[0]->next[0].compare_exchange_strong(expected, raw(node),
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed))
+                break;
+        }
+        // Upper levels are only shortcuts. An eraser may mark them at any
+        // time; once it has, stop linking - release() unlinks what we did link.
+        for (int level = 1; level < height; ++level) {
+            while (true) {
+                uintptr_t old = node->next[level].load(std::memory_order_acquire);
+                if (marked(old))
+                    goto stop;
+                if (old != raw(succs[level]) &&
+                    !node->next[level].compare_exchange_strong(old, raw(succs[level]),
+                                                               std::memory_order_acq_rel,
+                                                               std::memory_order_acquire))
+                    continue;  // Marked under us
+                uintptr_t expected = raw(succs[level]);
+                if (preds[level]->next[level].compare_exchange_strong(expected, raw(node),
+                                                                      std::memory_order_release,
+                                                                      std::memory_order_relaxed))
+                    break;
+                if (!find(key, preds, succs) || succs[0] != node)
+                    goto stop;  // Erased and already snipped from level 0
+            }
+        }
+    stop:
+        release(node, LINKED);
+        return true;
+    }
+
+    bool erase(int key) {
+        EpochGuard guard;
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        if (!find(key, preds, succs))
+            return false;
+        Node* victim = succs[0];
+
+        // Mark upper levels top-down (idempotent, any eraser may help). Levels
+        // the inserter hasn't linked yet get marked too, which stops it there
+        for (int level = victim->height - 1; level >= 1; --level) {
+            uintptr_t succ = victim->next[level].load(std::memory_order_acquire);
+            while (!marked(succ) &&
+                   !victim->next[level].compare_exchange_weak(succ, succ | 1,
+                                                              std::memory_order_acq_rel,
+                                                              std::memory_order_acquire)) {
+            }
+        }
+        // Level 0 decides who erased it
+        uintptr_t succ = victim->next[0].load(std::memory_order_acquire);
+        while (true) {
+            if (marked(succ))
+                return false;  // Another thread won
+            if (victim->next[0].compare_exchange_weak(succ, succ | 1,
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire))
+                break;
+        }
+        release(victim, ERASED);
+        return true;
+    }
+
+    bool find(int key, V& out) const {
+        EpochGuard guard;
+        Node* n = seek(key);
+        if (n == nullptr || n->key != key)
+            return false;
+        out = n->value.load(std::memory_order_acquire);
+        return true;
+    }
+
+    // First key >= `key`
+    bool lower_bound(int key, int& found_key, V& out) const {
+        EpochGuard guard;
+        Node* n = next_live(seek(key));
+        if (n == nullptr)
+            return false;
+        found_key = n->key;
+        out = n->value.load(std::memory_order_acquire);
+        return true;
+    }
+
+    // Weakly consistent view of [lo, hi). Holds an epoch guard for its
+    // lifetime, so keep it short-lived:
+    //     for (auto kv : map.range(10, 110)) { ... kv.first, kv.second ... }
+    class Range {
+    public:
+        class iterator {
+        public:
+            iterator(Node* n, int hi) : node(n), hi(hi) { settle(); }
+            std::pair<int, V> operator*() const {
+                return {node->key, node->value.load(std::memory_order_acquire)};
+            }
+            iterator& operator++() {
+                node = ptr(node->next[0].load(std::memory_order_acquire));
+                settle();
+                return *this;
+            }
+            bool operator!=(const iterator& o) const { return node != o.node; }
+
+        private:
+            Node* node;
+            int hi;
+            void settle() {
+                node = next_live(node);
+                if (node != nullptr && node->key >= hi)
+                    node = nullptr;
+            }
+        };
+
+        Range(const LockFreeSkipList& list, int lo, int hi)
+            : first(list.seek(lo)), hi(hi) {}
+        Range(const Range&) = delete;
+        Range& operator=(const Range&) = delete;
+
+        iterator begin() const { return iterator(first, hi); }
+        iterator end() const { return iterator(nullptr, hi); }
+
+    private:
+        EpochGuard guard;  // Declared first: pinned before seek() runs
+        Node* first;
+        int hi;
+    };
+
+    Range range(int lo, int hi) const { return Range(*this, lo, hi); }
+};
+
+// ============ BASELINE: std::map + std::shared_mutex ============
+template <typename V>
+class SharedMutexMap {
+private:
+    mutable std::shared_mutex mtx;
+    std::map<int, V> map;
+
+public:
+    bool insert(int key, V value) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        return map.emplace(key, value).second;
+    }
+
+    bool erase(int key) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        return map.erase(key) > 0;
+    }
+
+    bool find(int key, V& out) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        auto it = map.find(key);
+        if (it == map.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    // Sum of values in [lo, hi) - what the skiplist range loop computes
+    long scan(int lo, int hi) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        long sum = 0;
+        for (auto it = map.lower_bound(lo); it != map.end() && it->first < hi; ++it)
+            sum += it->second;
+        return sum;
+    }
+};
+
+template <typename V>
+long scan(const LockFreeSkipList<V>& list, int lo, int hi) {
+    long sum = 0;
+    for (auto kv : list.range(lo, hi))
+        sum += kv.second;
+    return sum;
+}
+
+template <typename V>
+long scan(const SharedMutexMap<V>& map, int lo, int hi) {
+    return map.scan(lo, hi);
+}
+
+// ============ BENCHMARK ============
+const int NUM_THREADS = 4;
+const int KEY_SPACE = 1 << 16;
+const int POINT_OPS = 200000;  // Per thread
+const int SCANS = 20000;       // Per thread
+const int SCAN_WIDTH = 100;
+
+template <typename Map>
+void point_worker(Map& map, int seed) {
+    FastRandom rng(seed);
+    long value;
+    for (int i = 0; i < POINT_OPS; ++i) {
+        int key = static_cast<int>(rng.next(KEY_SPACE));
+        int op = static_cast<int>(rng.next(100));
+        if (op < 80) map.find(key, value);
+        else if (op < 90) map.insert(key, key);
+        else map.erase(key);
+    }
+}
+
+// One writer thread keeps churning while the others scan
+template <typename Map>
+void scan_worker(Map& map, int seed, long& sink) {
+    FastRandom rng(seed);
+    long sum = 0;
+    for (int i = 0; i < SCANS; ++i) {
+        int lo = static_cast<int>(rng.next(KEY_SPACE - SCAN_WIDTH));
+        sum += scan(map, lo, lo + SCAN_WIDTH);
+    }
+    sink = sum;
+}
+
+template <typename Map>
+void churn_worker(Map& map, std::atomic<bool>& stop) {
+    FastRandom rng(12345);
+    while (!stop.load(std::memory_order_relaxed)) {
+        int key = static_cast<int>(rng.next(KEY_SPACE));
+        if (rng.next(2)) map.insert(key, key);
+        else map.erase(key);
+    }
+}
+
+template <typename Map>
+void prefill(Map& map) {
+    for (int k = 0; k < KEY_SPACE; k += 2)
+        map.insert(k, k);
+}
+
+template <typename Map>
+double bench_points() {
+    Map map;
+    prefill(map);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i)
+        threads.emplace_back(point_worker<Map>, std::ref(map), i + 1);
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    return static_cast<double>(NUM_THREADS) * POINT_OPS / us;  // Mops/s
+}
+
+template <typename Map>
+double bench_scans() {
+    Map map;
+    prefill(map);
+    std::atomic<bool> stop{false};
+    std::vector<long> sinks(NUM_THREADS - 1);
+    std::thread churn(churn_worker<Map>, std::ref(map), std::ref(stop));
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS - 1; ++i)
+        threads.emplace_back(scan_worker<Map>, std::ref(map), i + 1, std::ref(sinks[i]));
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    stop.store(true);
+    churn.join();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    return static_cast<double>(NUM_THREADS - 1) * SCANS / us * 1000.0;  // Kscans/s
+}
+
+bool self_test() {
+    LockFreeSkipList<long> list;
+    std::map<int, long> ref;
+    FastRandom rng(3);
+    for (int i = 0; i < 100000; ++i) {
+        int key = static_cast<int>(rng.next(3000));
+        long v;
+        switch (rng.next(4)) {
+        case 0:
+            if (list.insert(key, key) != ref.emplace(key, key).second) return false;
+            break;
+        case 1:
+            if (list.erase(key) != (ref.erase(key) > 0)) return false;
+            break;
+        case 2: {
+            int k;
+            auto it = ref.lower_bound(key);
+            bool found = list.lower_bound(key, k, v);
+            if (found != (it != ref.end()) || (found && k != it->first)) return false;
+            break;
+        }
+        default:
+            if (list.find(key, v) != (ref.count(key) > 0)) return false;
+        }
+    }
+    long expected = 0;
+    for (auto it = ref.lower_bound(500); it != ref.end() && it->first < 1500; ++it)
+        expected += it->second;
+    return scan(list, 500, 1500) == expected;
+}
+
+// Few keys, every thread inserting and erasing all of them: erases keep
+// landing on nodes whose inserter is still linking upper levels
+bool concurrent_test() {
+    LockFreeSkipList<long> list;
+    const int threads = 4;
+    const int keys = 64;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            FastRandom rng(t + 7);
+            for (int i = 0; i < 200000; ++i) {
+                int key = static_cast<int>(rng.next(keys));
+                if (rng.next(2)) list.insert(key, key);
+                else list.erase(key);
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    // Every key left must show up exactly once in a scan, then erase cleanly
+    int present = 0;
+    long v;
+    for (int key = 0; key < keys; ++key) present += list.find(key, v);
+    int scanned = 0, prev = -1;
+    for (auto kv : list.range(0, keys)) {
+        if (kv.first <= prev) return false;
+        prev = kv.first;
+        ++scanned;
+    }
+    if (scanned != present) return false;
+    for (int key = 0; key < keys; ++key) list.erase(key);
+    int k;
+    return !list.lower_bound(0, k, v);
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Lock-Free Skiplist Map with Range Scans           ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Self-test vs std::map: " << (self_test() ? "passed ✅" : "FAILED ❌") << "\n";
+    std::cout << "Concurrent insert/erase test: "
+              << (concurrent_test() ? "passed ✅" : "FAILED ❌") << "\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Threads: " << NUM_THREADS << "\n";
+    std::cout << "  Key space: " << KEY_SPACE << " (half prefilled)\n";
+    std::cout << "  Point ops: 80% find / 10% insert / 10% erase\n";
+    std::cout << "  Scans: " << SCAN_WIDTH << "-key ranges, " << NUM_THREADS - 1
+              << " scanners + 1 writer churning\n\n";
+
+    double points_map = bench_points<SharedMutexMap<long>>();
+    double points_skip = bench_points<LockFreeSkipList<long>>();
+    double scans_map = bench_scans<SharedMutexMap<long>>();
+    double scans_skip = bench_scans<LockFreeSkipList<long>>();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "┌──────────────────────────┬────────────────────┬────────────────────┐\n";
+    std::cout << "│ Structure                │ Point ops (Mops/s) │ Scans (K/s)        │\n";
+    std::cout << "├──────────────────────────┼────────────────────┼────────────────────┤\n";
+    std::cout << "│ std::map + shared_mutex  │ " << std::setw(18) << points_map << " │ "
+              << std::setw(18) << scans_map << " │\n";
+    std::cout << "│ Lock-free skiplist       │ " << std::setw(18) << points_skip << " │ "
+              << std::setw(18) << scans_skip << " │\n";
+    std::cout << "└──────────────────────────┴────────────────────┴────────────────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Readers never write: marked nodes are stepped over, not snipped\n";
+    std::cout << "• A scan holds one epoch guard instead of a shared lock\n";
+    std::cout << "  → the writer never waits for scanners, scanners never wait for it\n";
+    std::cout << "• Range results are weakly consistent (no snapshot isolation)\n";
+    std::cout << "• shared_mutex readers still write the lock word: reader-reader contention\n";
+    std::cout << "• Point ops pay ~log2(n) dependent cache misses plus the epoch guard;\n";
+    std::cout << "  the lock-free version wins once the lock is actually contended\n";
+
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+#include "backoff.hpp"
+#include "chase_lev_deque.hpp"
+
+// Work-stealing deque: Chase-Lev vs a mutex-protected std::deque
+// Test 1: owner-only push/pop cost (the common case in a work-stealing
+//         scheduler: a worker mostly runs its own tasks)
+// Test 2: steal throughput with one owner producing and N thieves stealing
+
+// ============ BASELINE: std::deque + std::mutex ============
+template <typename T>
+class MutexDeque {
+private:
+    std::mutex mtx;
+    std::deque<T> items;
+
+public:
+    void push(T item) {
+        std::lock_guard<std::mutex> lock(mtx);
+        items.push_back(item);
+    }
+
+    bool pop(T& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (items.empty()) return false;
+        out = items.back();
+        items.pop_back();
+        return true;
+    }
+
+    bool steal(T& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (items.empty()) return false;
+        out = items.front();
+        items.pop_front();
+        return true;
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return items.empty();
+    }
+};
+
+template <typename T>
+bool try_steal(MutexDeque<T>& d, T& out) { return d.steal(out); }
+
+template <typename T>
+bool try_steal(ChaseLevDeque<T>& d, T& out) {
+    return d.steal(out) == ChaseLevDeque<T>::Steal::Success;
+}
+
+// ============ TEST 1: OWNER PUSH/POP ============
+const int OWNER_ROUNDS = 200;
+const int OWNER_BATCH = 10000;
+
+struct OwnerResult {
+    double ns_per_op;
+    bool sum_ok;  // Popped sum == OWNER_ROUNDS x (0 + 1 + ... + OWNER_BATCH-1)
+};
+
+template <typename Deque>
+OwnerResult owner_push_pop() {
+    Deque d;
+    uint64_t sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < OWNER_ROUNDS; ++r) {
+        for (int i = 0; i < OWNER_BATCH; ++i)
+            d.push(static_cast<uint64_t>(i));
+        uint64_t v;
+        while (d.pop(v))
+            sink += v;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    const uint64_t expected = uint64_t(OWNER_ROUNDS) * OWNER_BATCH * (OWNER_BATCH - 1) / 2;
+    return {ns / (2.0 * OWNER_ROUNDS * OWNER_BATCH), sink == expected};
+}
+
+// ============ TEST 2: STEAL THROUGHPUT ============
+const uint64_t STEAL_ITEMS = 1000000;
+
+struct StealResult {
+    double mitems_per_sec;
+    double stolen_fraction;
+    bool sum_ok;
+};
+
+// Owner pushes 1..STEAL_ITEMS, popping one item every 4 pushes (as a worker
+// running its own tasks would). Thieves steal until everything is consumed.
+template <typename Deque>
+StealResult steal_benchmark(int num_thieves) {
+    Deque d;
+    std::atomic<bool> producing{true};
+    std::vector<uint64_t> thief_sums(num_thieves, 0);
+    std::vector<uint64_t> thief_counts(num_thieves, 0);
+    uint64_t owner_sum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < num_thieves; ++i) {
+        thieves.emplace_back([&, i] {
+            uint64_t sum = 0, count = 0, v;
+            while (true) {
+                if (try_steal(d, v)) {
+                    sum += v;
+                    ++count;
+                } else if (!producing.load(std::memory_order_acquire) && d.empty()) {
+                    break;
+                } else {
+                    cpu_relax();
+                }
+            }
+            thief_sums[i] = sum;
+            thief_counts[i] = count;
+        });
+    }
+
+    uint64_t v;
+    for (uint64_t i = 1; i <= STEAL_ITEMS; ++i) {
+        d.push(i);
+        if ((i & 3) == 0 && d.pop(v))
+            owner_sum += v;
+    }
+    while (d.pop(v))  // Drain what the thieves left
+        owner_sum += v;
+    producing.store(false, std::memory_order_release);
+
+    for (auto& t : thieves)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    uint64_t total = owner_sum, stolen = 0;
+    for (int i = 0; i < num_thieves; ++i) {
+        total += thief_sums[i];
+        stolen += thief_counts[i];
+    }
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    return {STEAL_ITEMS / us,
+            static_cast<double>(stolen) / STEAL_ITEMS,
+            total == STEAL_ITEMS * (STEAL_ITEMS + 1) / 2};
+}
+
+// Growth is only exercised if the owner outruns the thieves
+bool growth_test() {
+    ChaseLevDeque<uint64_t> d(4);
+    uint64_t sum = 0, v = 0;
+    for (uint64_t i = 1; i <= 10000; ++i) d.push(i);
+    for (int i = 0; i < 5000; ++i)  // Half from the top...
+        if (d.steal(v) == ChaseLevDeque<uint64_t>::Steal::Success) sum += v;
+    while (d.pop(v)) sum += v;      // ...the rest from the bottom
+    return sum == 10000ull * 10001 / 2 && d.capacity() >= 10000;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Chase-Lev Work-Stealing Deque                     ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Growth test (capacity 4 → 10000 items): "
+              << (growth_test() ? "passed ✅" : "FAILED ❌") << "\n\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Test 1: Owner-only push/pop (" << OWNER_BATCH << " pushes then pops, x"
+              << OWNER_ROUNDS << ")\n";
+    OwnerResult owner_mutex = owner_push_pop<MutexDeque<uint64_t>>();
+    OwnerResult owner_cl = owner_push_pop<ChaseLevDeque<uint64_t>>();
+    std::cout << "┌──────────────────────────┬──────────────┬────────┐\n";
+    std::cout << "│ Deque                    │ ns/op        │ Sum    │\n";
+    std::cout << "├──────────────────────────┼──────────────┼────────┤\n";
+    std::cout << "│ std::deque + mutex       │ " << std::setw(12) << owner_mutex.ns_per_op << " │ "
+              << (owner_mutex.sum_ok ? "ok ✅" : "BAD ❌") << "  │\n";
+    std::cout << "│ Chase-Lev                │ " << std::setw(12) << owner_cl.ns_per_op << " │ "
+              << (owner_cl.sum_ok ? "ok ✅" : "BAD ❌") << "  │\n";
+    std::cout << "└──────────────────────────┴──────────────┴────────┘\n\n";
+
+    std::cout << "Test 2: Steal throughput (" << STEAL_ITEMS
+              << " items, owner pops every 4th push)\n";
+    std::cout << "┌─────────┬──────────────────────────┬──────────────┬──────────┬────────┐\n";
+    std::cout << "│ Thieves │ Deque                    │ Mitems/s     │ Stolen   │ Sum    │\n";
+    std::cout << "├─────────┼──────────────────────────┼──────────────┼──────────┼────────┤\n";
+    const int thief_counts[] = {1, 2, 4, 8};
+    for (int n : thief_counts) {
+        StealResult m = steal_benchmark<MutexDeque<uint64_t>>(n);
+        StealResult c = steal_benchmark<ChaseLevDeque<uint64_t>>(n);
+        std::cout << "│ " << std::setw(7) << n << " │ std::deque + mutex       │ "
+                  << std::setw(12) << m.mitems_per_sec << " │ " << std::setw(7)
+                  << m.stolen_fraction * 100 << "% │ " << (m.sum_ok ? "ok ✅" : "BAD ❌")
+                  << "  │\n";
+        std::cout << "│ " << std::setw(7) << n << " │ Chase-Lev                │ "
+                  << std::setw(12) << c.mitems_per_sec << " │ " << std::setw(7)
+                  << c.stolen_fraction * 100 << "% │ " << (c.sum_ok ? "ok ✅" : "BAD ❌")
+                  << "  │\n";
+    }
+    std::cout << "└─────────┴──────────────────────────┴──────────────┴──────────┴────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Owner push/pop: plain loads/stores + one fence, no lock, no RMW\n";
+    std::cout << "• Only the last item (owner vs thief) and thief vs thief need a CAS\n";
+    std::cout << "• Thieves take the OLDEST work (top), the owner the newest (bottom):\n";
+    std::cout << "  they touch opposite ends, so they rarely meet on one cache line\n";
+    std::cout << "• A mutex serializes owner and thieves alike - every op is a lock RMW\n";
+
+    return 0;
+}
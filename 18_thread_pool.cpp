@@ -0,0 +1,179 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include "thread_pool.hpp"
+
+// Work-stealing pool vs a fresh std::thread per unit of work
+// Test 1: task spawn overhead (empty tasks)
+// Test 2: fine-grained parallel_for throughput
+// Test 3: a repo-style benchmark run (N threads hammering a CAS counter),
+//         repeated many times - the pattern every example here follows
+
+using Clock = std::chrono::high_resolution_clock;
+
+double elapsed_us(Clock::time_point start) {
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()) / 1000.0;
+}
+
+// ============ TEST 1: SPAWN OVERHEAD ============
+const int POOL_TASKS = 200000;
+const int THREAD_TASKS = 2000;  // std::thread is ~1000x slower; keep the run short
+
+double pool_spawn_ns(ThreadPool& pool) {
+    std::atomic<int> done{0};
+    auto start = Clock::now();
+    for (int i = 0; i < POOL_TASKS; ++i)
+        pool.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+    pool.wait_idle();
+    return elapsed_us(start) * 1000.0 / POOL_TASKS;
+}
+
+double thread_spawn_ns() {
+    std::atomic<int> done{0};
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(THREAD_TASKS);
+    for (int i = 0; i < THREAD_TASKS; ++i)
+        threads.emplace_back([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+    for (auto& t : threads)
+        t.join();
+    return elapsed_us(start) * 1000.0 / THREAD_TASKS;
+}
+
+// ============ TEST 2: FINE-GRAINED PARALLEL_FOR ============
+const int64_t ELEMENTS = 1 << 18;
+const int64_t GRAIN = 512;
+const int CALLS = 50;
+
+double pool_parallel_for_us(ThreadPool& pool, std::vector<double>& out) {
+    auto start = Clock::now();
+    for (int c = 0; c < CALLS; ++c)
+        pool.parallel_for(0, ELEMENTS, GRAIN, [&](int64_t i) { out[i] = std::sqrt(double(i + c)); });
+    return elapsed_us(start) / CALLS;
+}
+
+// What the examples do today: spawn T threads, split statically, join
+double spawn_parallel_for_us(unsigned num_threads, std::vector<double>& out) {
+    auto start = Clock::now();
+    for (int c = 0; c < CALLS; ++c) {
+        std::vector<std::thread> threads;
+        const int64_t chunk = (ELEMENTS + num_threads - 1) / num_threads;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t] {
+                const int64_t end = std::min(ELEMENTS, (t + 1) * chunk);
+                for (int64_t i = t * chunk; i < end; ++i)
+                    out[i] = std::sqrt(double(i + c));
+            });
+        }
+        for (auto& th : threads)
+            th.join();
+    }
+    return elapsed_us(start) / CALLS;
+}
+
+// ============ TEST 3: REPEATED BENCHMARK RUNS ============
+const int RUNS = 500;
+const int RUN_THREADS = 4;
+const int RUN_INCREMENTS = 1000;
+
+void cas_worker(std::atomic<long>& counter) {
+    for (int i = 0; i < RUN_INCREMENTS; ++i) {
+        long old = counter.load(std::memory_order_relaxed);
+        while (!counter.compare_exchange_weak(old, old + 1, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+double runs_on_pool_us(ThreadPool& pool, bool& ok) {
+    auto start = Clock::now();
+    for (int r = 0; r < RUNS; ++r) {
+        std::atomic<long> counter{0};
+        pool.parallel_for(0, RUN_THREADS, 1, [&](int64_t) { cas_worker(counter); });
+        ok = ok && counter.load() == long(RUN_THREADS) * RUN_INCREMENTS;
+    }
+    return elapsed_us(start) / RUNS;
+}
+
+double runs_on_threads_us(bool& ok) {
+    auto start = Clock::now();
+    for (int r = 0; r < RUNS; ++r) {
+        std::atomic<long> counter{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < RUN_THREADS; ++t)
+            threads.emplace_back(cas_worker, std::ref(counter));
+        for (auto& th : threads)
+            th.join();
+        ok = ok && counter.load() == long(RUN_THREADS) * RUN_INCREMENTS;
+    }
+    return elapsed_us(start) / RUNS;
+}
+
+int main() {
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned workers = std::max<unsigned>(hw, RUN_THREADS);
+
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Work-Stealing Thread Pool vs std::thread per Task ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    ThreadPool pool(workers);
+    std::cout << "Pool workers: " << pool.size() << " (hardware threads: " << hw << ")\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Test 1: Spawn overhead (empty tasks)\n";
+    double pool_ns = pool_spawn_ns(pool);
+    double thread_ns = thread_spawn_ns();
+    std::cout << "┌──────────────────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Method                   │ Tasks        │ ns/task      │\n";
+    std::cout << "├──────────────────────────┼──────────────┼──────────────┤\n";
+    std::cout << "│ std::thread per task     │ " << std::setw(12) << THREAD_TASKS << " │ "
+              << std::setw(12) << thread_ns << " │\n";
+    std::cout << "│ ThreadPool::submit       │ " << std::setw(12) << POOL_TASKS << " │ "
+              << std::setw(12) << pool_ns << " │\n";
+    std::cout << "└──────────────────────────┴──────────────┴──────────────┘\n\n";
+
+    std::cout << "Test 2: parallel_for over " << ELEMENTS << " elements (grain " << GRAIN
+              << ", " << ELEMENTS / GRAIN << " leaf tasks)\n";
+    std::vector<double> out(ELEMENTS);
+    double spawn_us = spawn_parallel_for_us(workers, out);
+    double for_us = pool_parallel_for_us(pool, out);
+    std::cout << "┌──────────────────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Method                   │ µs/call      │ Melems/s     │\n";
+    std::cout << "├──────────────────────────┼──────────────┼──────────────┤\n";
+    std::cout << "│ Spawn " << std::setw(2) << workers << " threads/call    │ " << std::setw(12)
+              << spawn_us << " │ " << std::setw(12) << ELEMENTS / spawn_us << " │\n";
+    std::cout << "│ ThreadPool::parallel_for │ " << std::setw(12) << for_us << " │ "
+              << std::setw(12) << ELEMENTS / for_us << " │\n";
+    std::cout << "└──────────────────────────┴──────────────┴──────────────┘\n\n";
+
+    std::cout << "Test 3: " << RUNS << " benchmark runs (" << RUN_THREADS << " workers x "
+              << RUN_INCREMENTS << " CAS increments each)\n";
+    bool threads_ok = true, pool_ok = true;
+    double threads_run_us = runs_on_threads_us(threads_ok);
+    double pool_run_us = runs_on_pool_us(pool, pool_ok);
+    std::cout << "┌──────────────────────────┬──────────────┬────────┐\n";
+    std::cout << "│ Method                   │ µs/run       │ Count  │\n";
+    std::cout << "├──────────────────────────┼──────────────┼────────┤\n";
+    std::cout << "│ Spawn + join per run     │ " << std::setw(12) << threads_run_us << " │ "
+              << (threads_ok ? "ok ✅" : "BAD ❌") << "  │\n";
+    std::cout << "│ ThreadPool::parallel_for │ " << std::setw(12) << pool_run_us << " │ "
+              << (pool_ok ? "ok ✅" : "BAD ❌") << "  │\n";
+    std::cout << "└──────────────────────────┴──────────────┴────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• A pool task costs one allocation + one deque push/pop,\n";
+    std::cout << "  a thread costs clone(), stack mmap and a join handshake\n";
+    std::cout << "• Recursive halving lets idle workers steal big chunks first (top of deque)\n";
+    std::cout << "• Waiting callers help run tasks, so nested parallel_for cannot deadlock\n";
+    std::cout << "• Idle workers spin briefly, then park - no CPU burned between runs\n";
+    std::cout << "• Caveat for contention benchmarks: with fewer cores than requested\n";
+    std::cout << "  workers, pool tasks run back-to-back instead of truly concurrently\n";
+
+    return 0;
+}
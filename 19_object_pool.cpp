@@ -0,0 +1,234 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include "object_pool.hpp"
+#include "epoch_reclaim.hpp"
+
+// Size-class object pool vs glibc malloc
+// Test 1: thread-local churn (allocate a batch, free it) at 1-64 threads
+// Test 2: cross-thread frees (each thread frees its neighbour's batch)
+// Test 3: the pool plugged into a 06-style lock-free stack via PoolAllocated
+
+// Same 32-byte node, two allocators
+struct PlainNode {
+    long data[3];
+    PlainNode* next;
+};
+
+struct PooledNode : PoolAllocated {
+    long data[3];
+    PooledNode* next;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Yielding barrier: 64 threads may share one core here
+class SpinBarrier {
+private:
+    std::atomic<int> arrived{0};
+    std::atomic<int> generation{0};
+    const int parties;
+
+public:
+    explicit SpinBarrier(int n) : parties(n) {}
+
+    void wait() {
+        const int gen = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+        } else {
+            while (generation.load(std::memory_order_acquire) == gen)
+                std::this_thread::yield();
+        }
+    }
+};
+
+// ============ TEST 1: LOCAL CHURN ============
+const int TOTAL_PAIRS = 4000000;  // Split across threads
+const int BATCH = 64;
+
+template <typename Node>
+double local_churn(int num_threads) {
+    const int rounds = TOTAL_PAIRS / BATCH / num_threads;
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([rounds] {
+            Node* batch[BATCH];
+            for (int r = 0; r < rounds; ++r) {
+                for (int i = 0; i < BATCH; ++i) {
+                    batch[i] = new Node;
+                    batch[i]->data[0] = i;
+                }
+                for (int i = BATCH - 1; i >= 0; --i)
+                    delete batch[i];
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    return static_cast<double>(rounds) * BATCH * num_threads / us;  // M pairs/s
+}
+
+// ============ TEST 2: CROSS-THREAD FREES ============
+const int CROSS_ROUNDS = 200;
+
+template <typename Node>
+double cross_thread_ns(int num_threads) {
+    std::vector<std::vector<Node*>> slots(num_threads, std::vector<Node*>(BATCH));
+    SpinBarrier barrier(num_threads);
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto& mine = slots[t];
+            auto& neighbour = slots[(t + 1) % num_threads];
+            for (int r = 0; r < CROSS_ROUNDS; ++r) {
+                for (int i = 0; i < BATCH; ++i)
+                    mine[i] = new Node;
+                barrier.wait();
+                for (int i = 0; i < BATCH; ++i)
+                    delete neighbour[i];  // Remote free unless num_threads == 1
+                barrier.wait();
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    return ns / (static_cast<double>(CROSS_ROUNDS) * BATCH * num_threads);
+}
+
+// ============ TEST 3: LOCK-FREE STACK NODES ============
+// 06_lockfree_stack.cpp with its "delete on pop" replaced by epoch_retire,
+// so nodes are freed later, often by another thread
+template <typename Node>
+class EpochStack {
+private:
+    std::atomic<Node*> head{nullptr};
+
+public:
+    ~EpochStack() {
+        Node* n = head.load();
+        while (n) {
+            Node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    void push(long value) {
+        Node* n = new Node;
+        n->data[0] = value;
+        n->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(n->next, n, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    bool pop(long& value) {
+        EpochGuard guard;
+        Node* n = head.load(std::memory_order_acquire);
+        while (n && !head.compare_exchange_weak(n, n->next, std::memory_order_acquire,
+                                                std::memory_order_acquire)) {
+        }
+        if (!n) return false;
+        value = n->data[0];
+        epoch_retire(n);
+        return true;
+    }
+};
+
+const int STACK_THREADS = 4;
+const int STACK_OPS = 500000;  // Push/pop pairs per thread
+
+template <typename Node>
+double stack_churn() {
+    EpochStack<Node> stack;
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < STACK_THREADS; ++t) {
+        threads.emplace_back([&stack, t] {
+            long v;
+            for (int i = 0; i < STACK_OPS; ++i) {
+                stack.push(t * STACK_OPS + i);
+                stack.pop(v);
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    return static_cast<double>(STACK_THREADS) * STACK_OPS / us;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Size-Class Object Pool vs malloc                  ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Node size: " << sizeof(PooledNode) << " bytes (size class "
+              << ObjectPool::class_size(ObjectPool::size_class(sizeof(PooledNode)))
+              << "), slabs of " << ObjectPool::SLAB_SIZE / 1024 << " KiB\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    const int thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    std::cout << "Test 1: Thread-local churn (new " << BATCH << ", delete " << BATCH
+              << ", repeat) - M pairs/s\n";
+    std::cout << "┌─────────┬──────────────┬──────────────┬──────────┐\n";
+    std::cout << "│ Threads │ malloc       │ ObjectPool   │ Speedup  │\n";
+    std::cout << "├─────────┼──────────────┼──────────────┼──────────┤\n";
+    for (int n : thread_counts) {
+        double m = local_churn<PlainNode>(n);
+        double p = local_churn<PooledNode>(n);
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << m << " │ "
+                  << std::setw(12) << p << " │ " << std::setw(7) << p / m << "x │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────────┴──────────┘\n\n";
+
+    std::cout << "Test 2: Cross-thread frees (alloc batch, barrier, free neighbour's) - ns/pair\n";
+    std::cout << "┌─────────┬──────────────┬──────────────┬──────────┐\n";
+    std::cout << "│ Threads │ malloc       │ ObjectPool   │ Speedup  │\n";
+    std::cout << "├─────────┼──────────────┼──────────────┼──────────┤\n";
+    for (int n : thread_counts) {
+        double m = cross_thread_ns<PlainNode>(n);
+        double p = cross_thread_ns<PooledNode>(n);
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << m << " │ "
+                  << std::setw(12) << p << " │ " << std::setw(7) << m / p << "x │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────────┴──────────┘\n\n";
+
+    std::cout << "Test 3: Lock-free stack with epoch reclamation (" << STACK_THREADS
+              << " threads) - Mops/s\n";
+    double stack_plain = stack_churn<PlainNode>();
+    double stack_pooled = stack_churn<PooledNode>();
+    std::cout << "┌──────────────────────────┬──────────────┐\n";
+    std::cout << "│ Node allocator           │ Mops/s       │\n";
+    std::cout << "├──────────────────────────┼──────────────┤\n";
+    std::cout << "│ malloc                   │ " << std::setw(12) << stack_plain << " │\n";
+    std::cout << "│ PoolAllocated mixin      │ " << std::setw(12) << stack_pooled << " │\n";
+    std::cout << "└──────────────────────────┴──────────────┘\n\n";
+
+    std::cout << "Slabs mapped: " << ObjectPool::slabs_in_use() << " ("
+              << ObjectPool::slabs_in_use() * ObjectPool::SLAB_SIZE / 1024 << " KiB)\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Local alloc/free is a pointer pop/push on a thread-local list\n";
+    std::cout << "• A remote free is one CAS on the owner's list; the owner reclaims\n";
+    std::cout << "  the whole list with a single exchange when it runs dry\n";
+    std::cout << "• Slab headers are found by masking the address: no per-object header\n";
+    std::cout << "• Exiting threads hand their heap to the next thread, so slabs are reused\n";
+    std::cout << "• Test 3 is bound by contention on the stack head, not the allocator\n";
+    std::cout << "• Trade-off: memory is never returned to the OS\n";
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <shared_mutex>
+#include <mutex>
+#include "rcu.hpp"
+
+// Userspace RCU vs std::shared_mutex for read-mostly configuration
+// The (x, y) pair from 03_atomic_broken.cpp, now with an invariant that
+// must hold for every reader: x == y. One writer publishes new versions;
+// N readers read both fields as often as they can.
+
+struct Config {
+    int x;
+    int y;
+    long version;
+    char name[48];
+};
+
+const auto RUN_TIME = std::chrono::milliseconds(200);
+const auto WRITE_INTERVAL = std::chrono::microseconds(50);
+
+struct Result {
+    double mreads_per_sec;
+    long writes;
+    long violations;
+};
+
+// ============ BASELINE: shared_mutex, update in place ============
+class LockedConfig {
+private:
+    mutable std::shared_mutex mtx;
+    Config cfg{0, 0, 0, "initial"};
+
+public:
+    bool read_consistent() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return cfg.x == cfg.y;
+    }
+
+    void update(int v) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        cfg.x = v;
+        cfg.y = v;
+        ++cfg.version;
+    }
+};
+
+// ============ RCU: copy, publish, defer the free ============
+class RcuConfig {
+private:
+    rcu_pointer<Config> cfg{new Config{0, 0, 0, "initial"}};
+
+public:
+    ~RcuConfig() {
+        synchronize_rcu();
+        delete cfg.load();
+    }
+
+    bool read_consistent() const {
+        RcuReadGuard guard;
+        const Config* c = cfg.load();
+        return c->x == c->y;
+    }
+
+    void update(int v) {
+        Config* fresh;
+        {
+            RcuReadGuard guard;
+            fresh = new Config(*cfg.load());  // Single writer: this is the latest
+        }
+        fresh->x = v;
+        fresh->y = v;
+        ++fresh->version;
+        call_rcu(cfg.exchange(fresh));
+    }
+};
+
+template <typename Shared>
+Result run(int num_readers) {
+    Shared shared;
+    std::vector<long> reads(num_readers, 0);
+    std::vector<long> bad(num_readers, 0);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + RUN_TIME;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&, i] {
+            // Readers watch the clock themselves: with a reader-preferring
+            // rwlock the writer may never get in to tell them to stop
+            long n = 0, violations = 0;
+            do {
+                for (int k = 0; k < 256; ++k) {
+                    if (!shared.read_consistent()) ++violations;
+                    ++n;
+                }
+            } while (std::chrono::steady_clock::now() < deadline);
+            reads[i] = n;
+            bad[i] = violations;
+        });
+    }
+
+    long writes = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        shared.update(static_cast<int>(++writes));
+        std::this_thread::sleep_for(WRITE_INTERVAL);
+    }
+    for (auto& t : readers)
+        t.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    Result r{0, writes, 0};
+    long total = 0;
+    for (int i = 0; i < num_readers; ++i) {
+        total += reads[i];
+        r.violations += bad[i];
+    }
+    r.mreads_per_sec = total / us;
+    return r;
+}
+
+// Grace-period latency seen by a writer that waits instead of deferring
+double synchronize_latency_us(int num_readers) {
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                RcuReadGuard guard;
+                cpu_relax();
+            }
+        });
+    }
+    const int calls = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i)
+        synchronize_rcu();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count()) / 1000.0;
+    stop.store(true);
+    for (auto& t : readers)
+        t.join();
+    return us / calls;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Userspace RCU vs std::shared_mutex                ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Invariant: every reader must see x == y (cf. 03_atomic_broken.cpp)\n";
+    std::cout << "1 writer, one update every " << WRITE_INTERVAL.count() << " µs, "
+              << RUN_TIME.count() << " ms per run\n\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "┌─────────┬──────────────┬────────┬──────────────┬────────┬──────────┐\n";
+    std::cout << "│ Readers │ rwlock Mrd/s │ Writes │ RCU Mrd/s    │ Writes │ Speedup  │\n";
+    std::cout << "├─────────┼──────────────┼────────┼──────────────┼────────┼──────────┤\n";
+    long violations = 0;
+    const int reader_counts[] = {1, 2, 4, 8, 16};
+    for (int n : reader_counts) {
+        Result locked = run<LockedConfig>(n);
+        Result rcu = run<RcuConfig>(n);
+        violations += locked.violations + rcu.violations;
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << locked.mreads_per_sec
+                  << " │ " << std::setw(6) << locked.writes << " │ " << std::setw(12)
+                  << rcu.mreads_per_sec << " │ " << std::setw(6) << rcu.writes << " │ "
+                  << std::setw(7) << rcu.mreads_per_sec / locked.mreads_per_sec << "x │\n";
+    }
+    std::cout << "└─────────┴──────────────┴────────┴──────────────┴────────┴──────────┘\n";
+    std::cout << "Invariant violations: " << violations << (violations == 0 ? " ✅" : " ❌")
+              << "\n\n";
+
+    std::cout << "synchronize_rcu() latency with 4 spinning readers: "
+              << synchronize_latency_us(4) << " µs\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• RCU read side: one store to a thread-owned slot, no RMW, no fence*\n";
+    std::cout << "• shared_mutex readers all RMW the same lock word → the line ping-pongs\n";
+    std::cout << "• Writers pay instead: a full copy per update and a grace period\n";
+    std::cout << "• Readers can never delay an RCU writer; a busy rwlock can starve it\n";
+    std::cout << "• call_rcu() defers the free, so the writer never blocks on readers\n";
+    std::cout << "• Readers may see the previous version briefly - never a torn one\n";
+    std::cout << "\n* with membarrier(); otherwise one fence (see 21_asymmetric_fence.cpp)\n";
+
+    return 0;
+}
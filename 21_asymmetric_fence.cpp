@@ -0,0 +1,191 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include "asymmetric_fence.hpp"
+#include "cpu_time.hpp"
+#include "epoch_reclaim.hpp"
+#include "rcu.hpp"
+
+// Asymmetric fences: who pays for store→load ordering?
+// Symmetric: every reader runs a seq_cst fence when it enters a protected
+// section. Asymmetric: readers run a compiler-only fence and the rare
+// reclaimer runs membarrier(), which fences every thread of the process.
+// Test 1: raw cost of each side
+// Test 2: EBR read path (EpochGuard + pointer chase), reclaimer in background
+// Test 3: RCU read path (RcuReadGuard + rcu_pointer load), writer in background
+
+// Every payload holds the same values, so a reader's sum is known up front
+struct Payload {
+    long value[4] = {1, 2, 3, 4};
+};
+
+// Sum of value[i & 3] over i = 0..n-1
+long expected_sum(long n) {
+    static const long prefix[4] = {0, 1, 3, 6};
+    return n / 4 * 10 + prefix[n % 4];
+}
+
+// ============ TEST 1: RAW FENCE COST ============
+const int RAW_ITERATIONS = 10000000;
+const int HEAVY_ITERATIONS = 20000;
+
+alignas(64) std::atomic<uint64_t> slot{0};
+alignas(64) std::atomic<Payload*> shared_ptr_slot{nullptr};
+
+struct RawResult {
+    double ns;
+    bool sum_ok;
+};
+
+template <typename Fence>
+RawResult announce_and_load(Fence fence, int iterations) {
+    Payload p;
+    shared_ptr_slot.store(&p);
+    long sum = 0;
+    double start = thread_cpu_ns();
+    for (int i = 0; i < iterations; ++i) {
+        slot.store(i, std::memory_order_relaxed);
+        fence();
+        sum += shared_ptr_slot.load(std::memory_order_acquire)->value[i & 3];
+    }
+    double ns = thread_cpu_ns() - start;
+    return {ns / iterations, sum == expected_sum(iterations)};
+}
+
+// ============ TEST 2/3: READ PATHS UNDER RECLAMATION ============
+const int READS = 2000000;  // Per reader
+const auto RECLAIM_INTERVAL = std::chrono::microseconds(100);
+
+struct ReadResult {
+    double read_ns;     // Per read, reader CPU time
+    double reclaim_us;  // Per update+retire on the background thread
+    long updates;
+    bool sums_ok;       // Every reader's sum matched: no torn or freed payload
+};
+
+// Guard: EpochGuard or RcuReadGuard; Retire: how the writer frees the old copy
+template <typename Guard, typename Retire>
+ReadResult read_path(int num_readers, Retire retire) {
+    std::atomic<Payload*> current{new Payload};
+    std::atomic<int> running{num_readers};
+    std::vector<double> ns(num_readers);
+    std::atomic<bool> sums_ok{true};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < num_readers; ++r) {
+        readers.emplace_back([&, r] {
+            long sum = 0;
+            double start = thread_cpu_ns();
+            for (int i = 0; i < READS; ++i) {
+                Guard guard;
+                sum += current.load(std::memory_order_acquire)->value[i & 3];
+            }
+            ns[r] = (thread_cpu_ns() - start) / READS;
+            if (sum != expected_sum(READS)) sums_ok.store(false);
+            running.fetch_sub(1);
+        });
+    }
+
+    long updates = 0;
+    double reclaim_ns = 0;
+    while (running.load() > 0) {
+        double start = thread_cpu_ns();
+        Payload* old = current.exchange(new Payload);
+        retire(old);
+        reclaim_ns += thread_cpu_ns() - start;
+        ++updates;
+        std::this_thread::sleep_for(RECLAIM_INTERVAL);
+    }
+    for (auto& t : readers)
+        t.join();
+    synchronize_rcu();
+    delete current.load();
+
+    double total = 0;
+    for (double v : ns) total += v;
+    return {total / num_readers, updates ? reclaim_ns / updates / 1000.0 : 0.0, updates,
+            sums_ok.load()};
+}
+
+void print_row(const char* label, int readers, const ReadResult& sym, const ReadResult& asym) {
+    std::cout << "│ " << std::left << std::setw(6) << label << std::right << " │ " << std::setw(7)
+              << readers << " │ " << std::setw(11) << sym.read_ns << " │ " << std::setw(11)
+              << asym.read_ns << " │ " << std::setw(7) << sym.read_ns / asym.read_ns << "x │ "
+              << std::setw(12) << sym.reclaim_us << " │ " << std::setw(12) << asym.reclaim_us
+              << " │\n";
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Asymmetric Fences via membarrier()                ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "membarrier(PRIVATE_EXPEDITED): "
+              << (AsymmetricFence::supported() ? "available ✅" : "unavailable (fallback: both sides fence)")
+              << "\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Test 1: Announce (store) + fence + protected load, ns/op\n";
+    RawResult none = announce_and_load([] {}, RAW_ITERATIONS);
+    RawResult compiler = announce_and_load(
+        [] { std::atomic_signal_fence(std::memory_order_seq_cst); }, RAW_ITERATIONS);
+    RawResult full = announce_and_load(
+        [] { std::atomic_thread_fence(std::memory_order_seq_cst); }, RAW_ITERATIONS);
+    AsymmetricFence::set_enabled(true);
+    RawResult heavy = announce_and_load([] { heavy_fence(); }, HEAVY_ITERATIONS);
+    std::cout << "┌──────────────────────────────────┬──────────────┐\n";
+    std::cout << "│ Fence                            │ ns/op        │\n";
+    std::cout << "├──────────────────────────────────┼──────────────┤\n";
+    std::cout << "│ None (incorrect)                 │ " << std::setw(12) << none.ns << " │\n";
+    std::cout << "│ Compiler only (asymmetric light) │ " << std::setw(12) << compiler.ns << " │\n";
+    std::cout << "│ seq_cst fence (symmetric)        │ " << std::setw(12) << full.ns << " │\n";
+    std::cout << "│ membarrier (asymmetric heavy)    │ " << std::setw(12) << heavy.ns << " │\n";
+    std::cout << "└──────────────────────────────────┴──────────────┘\n";
+    const bool raw_ok = none.sum_ok && compiler.sum_ok && full.sum_ok && heavy.sum_ok;
+    std::cout << (raw_ok ? "✅ Every loop read the expected payload sum\n\n"
+                         : "❌ A loop read the wrong payload sum\n\n");
+
+    auto ebr_retire = [](Payload* p) { epoch_retire(p); };
+    auto rcu_retire = [](Payload* p) { call_rcu(p); };
+
+    std::cout << "Test 2/3: Read path with a background writer retiring every "
+              << RECLAIM_INTERVAL.count() << " µs\n";
+    std::cout << "┌────────┬─────────┬─────────────┬─────────────┬──────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Scheme │ Readers │ Sym ns/op   │ Asym ns/op  │ Speedup  │ Sym µs/upd   │ Asym µs/upd  │\n";
+    std::cout << "├────────┼─────────┼─────────────┼─────────────┼──────────┼──────────────┼──────────────┤\n";
+    const int reader_counts[] = {1, 2, 4};
+    bool reads_ok = true;
+    for (int n : reader_counts) {
+        AsymmetricFence::set_enabled(false);
+        ReadResult sym = read_path<EpochGuard>(n, ebr_retire);
+        AsymmetricFence::set_enabled(true);
+        ReadResult asym = read_path<EpochGuard>(n, ebr_retire);
+        print_row("EBR", n, sym, asym);
+        reads_ok = reads_ok && sym.sums_ok && asym.sums_ok;
+    }
+    for (int n : reader_counts) {
+        AsymmetricFence::set_enabled(false);
+        ReadResult sym = read_path<RcuReadGuard>(n, rcu_retire);
+        AsymmetricFence::set_enabled(true);
+        ReadResult asym = read_path<RcuReadGuard>(n, rcu_retire);
+        print_row("RCU", n, sym, asym);
+        reads_ok = reads_ok && sym.sums_ok && asym.sums_ok;
+    }
+    std::cout << "└────────┴─────────┴─────────────┴─────────────┴──────────┴──────────────┴──────────────┘\n";
+    std::cout << (reads_ok ? "✅ Every reader summed intact payloads while they were retired\n\n"
+                           : "❌ A reader summed a torn or freed payload\n\n");
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• The reader's fence is the whole cost of entering a protected section\n";
+    std::cout << "• membarrier() costs far more (IPIs to every CPU running our threads),\n";
+    std::cout << "  but runs once per scan, not once per read\n";
+    std::cout << "  (EBR scans every " << EpochReclaimer::RETIRE_THRESHOLD << " retires, RCU every "
+              << RcuDomain::DEFER_THRESHOLD << " call_rcu)\n";
+    std::cout << "• Correctness is unchanged: the kernel issues the reader's fence for it\n";
+    std::cout << "• epoch_reclaim.hpp and rcu.hpp use it automatically when available\n";
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include "atomic_ref_ptr.hpp"
+
+// Snapshot publication: 1 writer replaces an immutable snapshot, N readers
+// grab the current one and read it.
+//   - std::shared_ptr behind a std::mutex
+//   - std::atomic<std::shared_ptr<T>> (C++20; libstdc++ uses a lock bit)
+//   - AtomicRefPtr<T>: split reference counts, lock-free (atomic_ref_ptr.hpp)
+// Build: this example needs -std=c++20 for the std::atomic<shared_ptr> row.
+
+struct Snapshot {
+    long version;
+    long values[14];  // All equal to version: a torn or freed read shows up
+
+    explicit Snapshot(long v) : version(v) {
+        for (long& x : values) x = v;
+    }
+
+    bool consistent() const {
+        for (long x : values)
+            if (x != version) return false;
+        return true;
+    }
+};
+
+const auto RUN_TIME = std::chrono::milliseconds(200);
+const auto PUBLISH_INTERVAL = std::chrono::microseconds(20);
+
+// ============ PUBLISHERS ============
+class MutexPublisher {
+private:
+    mutable std::mutex mtx;
+    std::shared_ptr<const Snapshot> current = std::make_shared<const Snapshot>(0);
+
+public:
+    std::shared_ptr<const Snapshot> load() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return current;
+    }
+
+    void publish(long v) {
+        auto fresh = std::make_shared<const Snapshot>(v);
+        std::lock_guard<std::mutex> lock(mtx);
+        current.swap(fresh);  // Old snapshot is freed after the unlock
+    }
+};
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+class StdAtomicPublisher {
+private:
+    std::atomic<std::shared_ptr<const Snapshot>> current{std::make_shared<const Snapshot>(0)};
+
+public:
+    std::shared_ptr<const Snapshot> load() const { return current.load(); }
+    void publish(long v) { current.store(std::make_shared<const Snapshot>(v)); }
+};
+#endif
+
+class RefPtrPublisher {
+private:
+    AtomicRefPtr<Snapshot> current{make_ref<Snapshot>(0)};
+
+public:
+    RefPtr<Snapshot> load() const { return current.load(); }
+    void publish(long v) { current.store(make_ref<Snapshot>(v)); }
+};
+
+// ============ BENCHMARK ============
+struct Result {
+    double mloads_per_sec;
+    long publishes;
+    long bad;
+};
+
+template <typename Publisher>
+Result run(int num_readers) {
+    Publisher pub;
+    std::vector<long> loads(num_readers, 0);
+    std::vector<long> bad(num_readers, 0);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + RUN_TIME;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&, i] {
+            long n = 0, errors = 0, last = 0;
+            do {
+                for (int k = 0; k < 256; ++k) {
+                    auto snap = pub.load();
+                    if (!snap->consistent() || snap->version < last) ++errors;
+                    last = snap->version;
+                    ++n;
+                }
+            } while (std::chrono::steady_clock::now() < deadline);
+            loads[i] = n;
+            bad[i] = errors;
+        });
+    }
+
+    long publishes = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        pub.publish(++publishes);
+        std::this_thread::sleep_for(PUBLISH_INTERVAL);
+    }
+    for (auto& t : readers)
+        t.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    Result r{0, publishes, 0};
+    long total = 0;
+    for (int i = 0; i < num_readers; ++i) {
+        total += loads[i];
+        r.bad += bad[i];
+    }
+    r.mloads_per_sec = total / us;
+    return r;
+}
+
+// compare_exchange under contention: every thread bumps a shared version
+bool cas_test() {
+    AtomicRefPtr<Snapshot> shared(make_ref<Snapshot>(0));
+    const int threads = 4, per_thread = 20000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < per_thread; ++i) {
+                RefPtr<Snapshot> cur = shared.load();
+                while (!shared.compare_exchange(cur, make_ref<Snapshot>(cur->version + 1))) {
+                }
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    return shared.load()->version == long(threads) * per_thread;
+}
+
+// Re-publishing a block readers may still hold - store() of a loaded RefPtr,
+// compare_exchange back to an older one - must neither leak nor free early
+struct Tracked {
+    static std::atomic<long> live;
+    long version;
+
+    explicit Tracked(long v) : version(v) { live.fetch_add(1, std::memory_order_relaxed); }
+    ~Tracked() {
+        version = -1;  // A reader that still sees this one read freed memory
+        live.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+std::atomic<long> Tracked::live{0};
+
+bool republish_test() {
+    {
+        AtomicRefPtr<Tracked> shared(make_ref<Tracked>(0));
+        // More loads of one installation than 16 bits of external count hold
+        for (int i = 0; i < 200000; ++i)
+            if (shared.load()->version != 0) return false;
+
+        std::atomic<bool> stop{false};
+        std::atomic<long> bad{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&] {
+                RefPtr<Tracked> held[8];  // Keep references alive across republishes
+                long errors = 0;
+                for (unsigned i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+                    RefPtr<Tracked> p = shared.load();
+                    errors += p->version < 0;
+                    held[i & 7] = std::move(p);
+                }
+                bad.fetch_add(errors);
+            });
+        }
+        // Ping-pong between two blocks obtained from load(): a reader stalled
+        // mid-load almost always resumes to find its block installed again
+        RefPtr<Tracked> a = shared.load();
+        shared.store(make_ref<Tracked>(1));
+        RefPtr<Tracked> b = shared.load();
+        const auto deadline = std::chrono::steady_clock::now() + RUN_TIME;
+        for (long i = 2; std::chrono::steady_clock::now() < deadline; ++i) {
+            if (i % 64 == 0) {
+                b = make_ref<Tracked>(i);  // Retire one now and then
+                shared.store(b);
+            } else if (i & 1) {
+                shared.store(a);
+            } else {
+                RefPtr<Tracked> cur = shared.load();
+                shared.compare_exchange(cur, cur == a ? b : a);
+            }
+        }
+        stop.store(true);
+        for (auto& r : readers)
+            r.join();
+        if (bad.load() != 0) return false;
+    }
+    return Tracked::live.load() == 0;  // Every block freed exactly once
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Lock-Free Atomic Shared Pointer                   ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "AtomicRefPtr lock-free: " << (AtomicRefPtr<Snapshot>::is_always_lock_free ? "yes" : "no");
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::cout << " | std::atomic<shared_ptr> lock-free: "
+              << (std::atomic<std::shared_ptr<const Snapshot>>::is_always_lock_free ? "yes" : "no");
+#endif
+    std::cout << "\nCAS test (4 threads x 20000 increments): "
+              << (cas_test() ? "passed ✅" : "FAILED ❌") << "\n";
+    std::cout << "Re-publish test (loaded snapshots stored again, 3 readers): "
+              << (republish_test() ? "passed ✅" : "FAILED ❌") << "\n";
+    std::cout << "1 writer publishing every " << PUBLISH_INTERVAL.count() << " µs, "
+              << RUN_TIME.count() << " ms per run\n\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "┌─────────┬──────────────────────────────┬──────────────┬───────────┬────────┐\n";
+    std::cout << "│ Readers │ Publisher                    │ Mloads/s     │ Publishes │ Errors │\n";
+    std::cout << "├─────────┼──────────────────────────────┼──────────────┼───────────┼────────┤\n";
+    auto row = [](int n, const char* name, const Result& r) {
+        std::cout << "│ " << std::setw(7) << n << " │ " << name << " │ " << std::setw(12)
+                  << r.mloads_per_sec << " │ " << std::setw(9) << r.publishes << " │ "
+                  << std::setw(6) << r.bad << " │\n";
+    };
+    const int reader_counts[] = {1, 2, 4, 8, 16};
+    for (int n : reader_counts) {
+        row(n, "mutex + shared_ptr          ", run<MutexPublisher>(n));
+#if defined(__cpp_lib_atomic_shared_ptr)
+        row(n, "std::atomic<shared_ptr>     ", run<StdAtomicPublisher>(n));
+#endif
+        row(n, "AtomicRefPtr (split counts) ", run<RefPtrPublisher>(n));
+    }
+    std::cout << "└─────────┴──────────────────────────────┴──────────────┴───────────┴────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• std::atomic<shared_ptr> spins on a lock bit: a preempted holder\n";
+    std::cout << "  stalls every reader, exactly like the mutex\n";
+    std::cout << "• Split counts: a reader's reference starts as a bump of the count in\n";
+    std::cout << "  the pointer word, so the writer can never free a snapshot it is pinning\n";
+    std::cout << "• Still an RMW per load and per release on shared lines - refcounting\n";
+    std::cout << "  doesn't scale like RCU (20_userspace_rcu.cpp), but needs no grace periods\n";
+
+    return 0;
+}
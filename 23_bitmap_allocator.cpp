@@ -0,0 +1,267 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BITMAP_HAVE_AVX2_PATH 1
+#else
+#define BITMAP_HAVE_AVX2_PATH 0
+#endif
+
+// Lock-free slot allocator: one bit per slot, 1 = taken
+// allocate: find a word that is not all ones, pick its lowest clear bit and
+//           claim it with fetch_or - the returned old value says if we won
+// free:     fetch_and(~bit)
+// Each thread starts searching at its own hint (the last word it allocated
+// from), so threads spread over the bitmap instead of all fighting over
+// word 0. Finding a non-full word is a linear scan, done 4 words (256 slots)
+// at a time with AVX2 when the CPU has it.
+
+// ============ WORD SCANNING ============
+// Returns the first index in [from, to) whose word is not all ones, or `to`.
+// The loads are plain reads of words other threads update atomically: the
+// scan is only a hint, every claim is re-checked by fetch_or.
+
+size_t scan_scalar(const uint64_t* words, size_t from, size_t to) {
+    for (size_t i = from; i < to; ++i)
+        if (__atomic_load_n(&words[i], __ATOMIC_RELAXED) != ~0ull) return i;
+    return to;
+}
+
+#if BITMAP_HAVE_AVX2_PATH
+__attribute__((target("avx2")))
+size_t scan_avx2(const uint64_t* words, size_t from, size_t to) {
+    // The hinted word usually has room: don't pay for a vector compare
+    if (from < to && __atomic_load_n(&words[from], __ATOMIC_RELAXED) != ~0ull) return from;
+    const __m256i full = _mm256_set1_epi64x(-1);
+    size_t i = from;
+    for (; i + 4 <= to; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        int full_mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, full)));
+        if (full_mask != 0xF)
+            return i + __builtin_ctz(~full_mask & 0xF);
+    }
+    return scan_scalar(words, i, to);
+}
+#endif
+
+using ScanFn = size_t (*)(const uint64_t*, size_t, size_t);
+
+ScanFn best_scan() {
+#if BITMAP_HAVE_AVX2_PATH
+    if (__builtin_cpu_supports("avx2")) return scan_avx2;
+#endif
+    return scan_scalar;
+}
+
+// ============ BITMAP ALLOCATOR ============
+class BitmapAllocator {
+public:
+    static constexpr int NONE = -1;
+
+    explicit BitmapAllocator(size_t capacity, ScanFn scan = best_scan())
+        : num_words((capacity + 63) / 64), words(new uint64_t[num_words]()), scan(scan) {
+        if (capacity % 64)  // Tail bits past capacity are permanently taken
+            words[num_words - 1] = ~0ull << (capacity % 64);
+    }
+
+    int allocate() {
+        size_t& hint = thread_hint();
+        size_t start = hint % num_words;
+        // Two passes: [hint, end) then [0, hint)
+        for (int pass = 0; pass < 2; ++pass) {
+            size_t from = pass == 0 ? start : 0;
+            size_t to = pass == 0 ? num_words : start;
+            while (from < to) {
+                size_t w = scan(words.get(), from, to);
+                if (w == to) break;
+                uint64_t cur = __atomic_load_n(&words[w], __ATOMIC_RELAXED);
+                while (cur != ~0ull) {
+                    const uint64_t bit = ~cur & (cur + 1);  // Lowest clear bit
+                    cur = __atomic_fetch_or(&words[w], bit, __ATOMIC_ACQUIRE);
+                    if (!(cur & bit)) {
+                        hint = w;
+                        return static_cast<int>(w * 64 + __builtin_ctzll(bit));
+                    }
+                }
+                from = w + 1;  // Filled up under us: keep scanning
+            }
+        }
+        return NONE;  // Full
+    }
+
+    void free(int slot) {
+        const uint64_t bit = uint64_t(1) << (slot % 64);
+        __atomic_fetch_and(&words[slot / 64], ~bit, __ATOMIC_RELEASE);
+    }
+
+private:
+    const size_t num_words;
+    std::unique_ptr<uint64_t[]> words;  // Accessed only through __atomic builtins
+    const ScanFn scan;
+
+    // Spread starting points: a hash of the thread id, then the last hit
+    size_t& thread_hint() {
+        thread_local size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        return hint;
+    }
+};
+
+// ============ BASELINE: mutex + free list ============
+class MutexFreeList {
+private:
+    std::mutex mtx;
+    std::vector<int> free_slots;
+
+public:
+    explicit MutexFreeList(size_t capacity) {
+        for (size_t i = capacity; i-- > 0;)
+            free_slots.push_back(static_cast<int>(i));
+    }
+
+    int allocate() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (free_slots.empty()) return -1;
+        int s = free_slots.back();
+        free_slots.pop_back();
+        return s;
+    }
+
+    void free(int slot) {
+        std::lock_guard<std::mutex> lock(mtx);
+        free_slots.push_back(slot);
+    }
+};
+
+// ============ BENCHMARKS ============
+const size_t CAPACITY = 65536;
+const double PREFILL = 0.90;  // Long-lived connections occupy most slots
+const int PAIRS = 1000000;    // Per thread
+const int HOLD = 16;          // Each thread keeps this many slots in flight
+
+struct PairResult {
+    double mpairs_per_sec;
+    bool no_duplicates;
+};
+
+template <typename Alloc>
+PairResult alloc_free_pairs(Alloc& alloc, int num_threads) {
+    std::vector<std::atomic<uint8_t>> owned(CAPACITY);  // Detects double allocation
+    std::atomic<bool> dup{false};
+    for (size_t i = 0; i < CAPACITY * PREFILL; ++i)
+        owned[alloc.allocate()].store(1);
+
+    const int pairs = PAIRS / num_threads;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&] {
+            int ring[HOLD];  // FIFO of held slots: [head, tail)
+            int head = 0, tail = 0;
+            for (int i = 0; i < pairs; ++i) {
+                if (tail - head == HOLD) {  // Release the oldest
+                    int s = ring[head++ % HOLD];
+                    owned[s].store(0, std::memory_order_relaxed);
+                    alloc.free(s);
+                }
+                int s = alloc.allocate();
+                if (s < 0) continue;  // Full: nothing to hold this round
+                if (owned[s].exchange(1, std::memory_order_relaxed)) dup.store(true);
+                ring[tail++ % HOLD] = s;
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    return {static_cast<double>(pairs) * num_threads / us, !dup.load()};
+}
+
+struct ScanResult {
+    double ns;
+    long wrong;  // Scans that didn't return the free last word
+};
+
+// Worst case: everything full except the very last word
+ScanResult scan_ns(ScanFn scan) {
+    const size_t n = CAPACITY / 64;
+    std::vector<uint64_t> words(n, ~0ull);
+    words[n - 1] = 0;
+    const int reps = 20000;
+    long wrong = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < reps; ++r)
+        wrong += scan(words.data(), r & 1, n) != n - 1;
+    auto end = std::chrono::high_resolution_clock::now();
+    return {static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / reps,
+            wrong};
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Lock-Free Bitmap Slot Allocator                   ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    const bool have_avx2 = best_scan() != scan_scalar;
+    std::cout << "Capacity: " << CAPACITY << " slots (" << CAPACITY / 64 << " words), "
+              << PREFILL * 100 << "% prefilled, " << HOLD << " slots held per thread\n";
+    std::cout << "AVX2 scan: " << (have_avx2 ? "available ✅" : "not available (scalar only)")
+              << "\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Test 1: Full-bitmap scan (" << CAPACITY / 64 << " words, free word at the end)\n";
+    auto scan_row = [](const char* label, ScanFn scan) {
+        ScanResult r = scan_ns(scan);
+        std::cout << "│ " << label << " │ " << std::setw(12) << r.ns << " │ " << std::setw(8)
+                  << r.wrong << " │\n";
+        return r.wrong;
+    };
+    std::cout << "┌──────────────────────────┬──────────────┬──────────┐\n";
+    std::cout << "│ Scan                     │ ns/scan      │ Wrong    │\n";
+    std::cout << "├──────────────────────────┼──────────────┼──────────┤\n";
+    long wrong = scan_row("Scalar (1 word/step)    ", scan_scalar);
+    if (have_avx2)
+        wrong += scan_row("AVX2 (4 words/step)     ", best_scan());
+    std::cout << "└──────────────────────────┴──────────────┴──────────┘\n";
+    std::cout << (wrong == 0 ? "✅ Every scan found the free last word\n\n"
+                             : "❌ Some scans missed the free last word\n\n");
+
+    std::cout << "Test 2: Allocate/free pairs - M pairs/s\n";
+    std::cout << "┌─────────┬──────────────┬──────────────┬──────────────┬────────┐\n";
+    std::cout << "│ Threads │ Mutex list   │ Bitmap scal. │ Bitmap best  │ Unique │\n";
+    std::cout << "├─────────┼──────────────┼──────────────┼──────────────┼────────┤\n";
+    const int thread_counts[] = {1, 2, 4, 8};
+    for (int n : thread_counts) {
+        MutexFreeList list(CAPACITY);
+        BitmapAllocator scalar(CAPACITY, scan_scalar);
+        BitmapAllocator best(CAPACITY);
+        PairResult l = alloc_free_pairs(list, n);
+        PairResult s = alloc_free_pairs(scalar, n);
+        PairResult b = alloc_free_pairs(best, n);
+        bool ok = l.no_duplicates && s.no_duplicates && b.no_duplicates;
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << l.mpairs_per_sec
+                  << " │ " << std::setw(12) << s.mpairs_per_sec << " │ " << std::setw(12)
+                  << b.mpairs_per_sec << " │ " << (ok ? "ok ✅" : "DUP ❌") << "  │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────────┴──────────────┴────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• fetch_or claims a bit in one RMW; the old value tells us if we won\n";
+    std::cout << "• Per-thread hints keep threads in different words (different lines)\n";
+    std::cout << "• AVX2 checks 256 slots per compare - it matters when the map is full\n";
+    std::cout << "• A free list is LIFO on one lock; the bitmap has no shared head at all\n";
+    std::cout << "• 1 bit per slot: 64K slots = 8 KiB, vs 256 KiB for a vector<int> list\n";
+
+    return 0;
+}
@@ -0,0 +1,276 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <new>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BLOOM_HAVE_AVX2_PATH 1
+#else
+#define BLOOM_HAVE_AVX2_PATH 0
+#endif
+
+// Concurrent blocked Bloom filter (split-block layout, as in Impala/Parquet)
+// Each key maps to ONE 256-bit block = 8 x 32-bit words, and sets exactly
+// one bit in each word (k = 8). The 8 bit positions come from multiplying
+// the key's hash by 8 odd salts - one SIMD multiply for all 8 lanes.
+// Blocks are 32-byte aligned, so a key touches a single cache line.
+//   insert:   fetch_or(relaxed) only on words that are missing the bit
+//   contains: plain loads, AND with the mask, compare
+// Bits only ever go 0 → 1, so a racing reader can miss a concurrent insert
+// but can never see a false negative for an insert that happened-before it.
+
+class BlockedBloomFilter {
+public:
+    static constexpr int WORDS = 8;
+    static constexpr int BATCH = 16;
+
+    BlockedBloomFilter(size_t expected_keys, double bits_per_key, bool use_simd = true)
+        : num_blocks(std::max<size_t>(1, size_t(expected_keys * bits_per_key) / 256)),
+          blocks(static_cast<Block*>(::operator new(num_blocks * sizeof(Block), std::align_val_t(64)))),
+          simd(use_simd && simd_supported()) {
+        std::memset(static_cast<void*>(blocks), 0, num_blocks * sizeof(Block));
+    }
+
+    ~BlockedBloomFilter() { ::operator delete(blocks, std::align_val_t(64)); }
+
+    BlockedBloomFilter(const BlockedBloomFilter&) = delete;
+    BlockedBloomFilter& operator=(const BlockedBloomFilter&) = delete;
+
+    static bool simd_supported() {
+#if BLOOM_HAVE_AVX2_PATH
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    size_t bits() const { return num_blocks * 256; }
+    size_t block_count() const { return num_blocks; }
+    bool using_simd() const { return simd; }
+
+    void insert(uint64_t key) {
+        const uint64_t h = hash(key);
+        uint32_t mask[WORDS];
+        make_mask(static_cast<uint32_t>(h), mask);
+        uint32_t* w = blocks[block_index(h)].words;
+        for (int i = 0; i < WORDS; ++i) {
+            // Skip the RMW (and the cache-line write) if the bit is already set
+            if ((__atomic_load_n(&w[i], __ATOMIC_RELAXED) & mask[i]) != mask[i])
+                __atomic_fetch_or(&w[i], mask[i], __ATOMIC_RELAXED);
+        }
+    }
+
+    bool contains(uint64_t key) const {
+        const uint64_t h = hash(key);
+        const Block& b = blocks[block_index(h)];
+#if BLOOM_HAVE_AVX2_PATH
+        if (simd) return contains_avx2(b, static_cast<uint32_t>(h));
+#endif
+        uint32_t mask[WORDS];
+        make_mask(static_cast<uint32_t>(h), mask);
+        for (int i = 0; i < WORDS; ++i)
+            if ((__atomic_load_n(&b.words[i], __ATOMIC_RELAXED) & mask[i]) != mask[i]) return false;
+        return true;
+    }
+
+    // Hash the whole batch and prefetch every block before testing any of
+    // them: BATCH independent cache misses in flight instead of one at a time
+    void contains_batch(const uint64_t* keys, size_t n, bool* out) const {
+        uint64_t h[BATCH];
+        for (size_t base = 0; base < n; base += BATCH) {
+            const size_t m = std::min<size_t>(BATCH, n - base);
+            for (size_t i = 0; i < m; ++i) {
+                h[i] = hash(keys[base + i]);
+                __builtin_prefetch(&blocks[block_index(h[i])]);
+            }
+            for (size_t i = 0; i < m; ++i) {
+                const Block& b = blocks[block_index(h[i])];
+#if BLOOM_HAVE_AVX2_PATH
+                if (simd) {
+                    out[base + i] = contains_avx2(b, static_cast<uint32_t>(h[i]));
+                    continue;
+                }
+#endif
+                uint32_t mask[WORDS];
+                make_mask(static_cast<uint32_t>(h[i]), mask);
+                bool hit = true;
+                for (int w = 0; w < WORDS; ++w)
+                    hit &= (__atomic_load_n(&b.words[w], __ATOMIC_RELAXED) & mask[w]) == mask[w];
+                out[base + i] = hit;
+            }
+        }
+    }
+
+private:
+    struct alignas(32) Block {
+        uint32_t words[WORDS];
+    };
+
+    static constexpr uint32_t SALT[WORDS] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                             0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    const size_t num_blocks;
+    Block* blocks;  // Words are accessed through __atomic builtins or SIMD loads
+    const bool simd;
+
+    static uint64_t hash(uint64_t key) {  // splitmix64 finalizer
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ull;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebull;
+        return key ^ (key >> 31);
+    }
+
+    // High 32 bits pick the block (multiply-shift instead of modulo)
+    size_t block_index(uint64_t h) const { return ((h >> 32) * num_blocks) >> 32; }
+
+    // Low 32 bits pick one bit per word: top 5 bits of h * salt[i]
+    static void make_mask(uint32_t h, uint32_t* mask) {
+        for (int i = 0; i < WORDS; ++i)
+            mask[i] = uint32_t(1) << ((h * SALT[i]) >> 27);
+    }
+
+#if BLOOM_HAVE_AVX2_PATH
+    __attribute__((target("avx2")))
+    static bool contains_avx2(const Block& b, uint32_t h) {
+        const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(SALT));
+        __m256i idx = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(int(h)), salt), 27);
+        __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), idx);
+        __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(b.words));
+        return _mm256_testc_si256(block, mask);  // (~block & mask) == 0
+    }
+#endif
+};
+
+// ============ FALSE-POSITIVE THEORY ============
+// Split-block filter: a block holding i keys has each word bit set with
+// p = 1 - (1 - 1/32)^i; a false positive needs all 8 words. Block loads are
+// Poisson(n / blocks).
+double theoretical_fpr_blocked(size_t n, size_t blocks) {
+    const double lambda = double(n) / blocks;
+    double fpr = 0, poisson = std::exp(-lambda);
+    for (int i = 0; i < 1000; ++i) {
+        if (i > 0) poisson *= lambda / i;
+        fpr += poisson * std::pow(1 - std::pow(1 - 1.0 / 32, i), 8);
+    }
+    return fpr;
+}
+
+// Classic Bloom filter with the same m and k, for reference
+double theoretical_fpr_classic(size_t n, size_t m, int k) {
+    return std::pow(1 - std::exp(-double(k) * n / m), k);
+}
+
+// ============ BENCHMARK ============
+const size_t NUM_KEYS = 1 << 22;  // 4M keys
+const double BITS_PER_KEY = 16;
+const size_t QUERIES = 1 << 22;
+
+uint64_t present_key(uint64_t i) { return i * 2 + 1; }  // Odd keys inserted
+uint64_t absent_key(uint64_t i) { return i * 2 + 2; }   // Even keys never inserted
+
+template <typename Fn>
+double timed_mops(int num_threads, size_t total, Fn fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    const size_t per = total / num_threads;
+    for (int t = 0; t < num_threads; ++t)
+        threads.emplace_back(fn, t * per, (t + 1) * per);
+    for (auto& th : threads)
+        th.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count());
+    return per * num_threads / us;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Concurrent Blocked Bloom Filter                   ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    {
+        BlockedBloomFilter probe(NUM_KEYS, BITS_PER_KEY);
+        std::cout << "Keys: " << NUM_KEYS << ", " << BITS_PER_KEY << " bits/key ("
+                  << probe.bits() / 8 / 1024 << " KiB), k = " << BlockedBloomFilter::WORDS
+                  << ", 256-bit blocks\n";
+        std::cout << "SIMD (AVX2) bit test: " << (probe.using_simd() ? "yes ✅" : "no (scalar)")
+                  << "\n\n";
+    }
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "┌─────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Threads │ Insert Mops  │ Query Mops   │ Batch Mops   │ Scalar batch │\n";
+    std::cout << "├─────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+    double measured_fpr = 0;
+    size_t false_negatives = 0;
+    const int thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    for (int n : thread_counts) {
+        BlockedBloomFilter filter(NUM_KEYS, BITS_PER_KEY);
+        BlockedBloomFilter scalar(NUM_KEYS, BITS_PER_KEY, false);
+
+        double insert = timed_mops(n, NUM_KEYS, [&](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) filter.insert(present_key(i));
+        });
+        for (size_t i = 0; i < NUM_KEYS; ++i) scalar.insert(present_key(i));
+
+        std::atomic<size_t> hits{0};
+        double query = timed_mops(n, QUERIES, [&](size_t from, size_t to) {
+            size_t h = 0;
+            for (size_t i = from; i < to; ++i) h += filter.contains(absent_key(i));
+            hits += h;
+        });
+        measured_fpr = double(hits.load()) / (QUERIES / n * n);
+
+        auto batch_query = [&](const BlockedBloomFilter& f, std::atomic<size_t>& missing) {
+            return timed_mops(n, QUERIES, [&](size_t from, size_t to) {
+                uint64_t keys[BlockedBloomFilter::BATCH];
+                bool out[BlockedBloomFilter::BATCH];
+                size_t miss = 0;
+                for (size_t i = from; i + BlockedBloomFilter::BATCH <= to; i += BlockedBloomFilter::BATCH) {
+                    for (int j = 0; j < BlockedBloomFilter::BATCH; ++j) keys[j] = present_key((i + j) % NUM_KEYS);
+                    f.contains_batch(keys, BlockedBloomFilter::BATCH, out);
+                    for (int j = 0; j < BlockedBloomFilter::BATCH; ++j) miss += !out[j];
+                }
+                missing += miss;
+            });
+        };
+        std::atomic<size_t> missing{0};
+        double batch = batch_query(filter, missing);
+        double scalar_batch = batch_query(scalar, missing);
+        false_negatives += missing.load();
+
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << insert << " │ "
+                  << std::setw(12) << query << " │ " << std::setw(12) << batch << " │ "
+                  << std::setw(12) << scalar_batch << " │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n";
+    std::cout << "False negatives: " << false_negatives << (false_negatives == 0 ? " ✅" : " ❌")
+              << "\n\n";
+
+    BlockedBloomFilter sizing(NUM_KEYS, BITS_PER_KEY);
+    std::cout << std::setprecision(4);
+    std::cout << "False-positive rate (" << QUERIES << " absent keys):\n";
+    std::cout << "  Measured:                    " << measured_fpr * 100 << "%\n";
+    std::cout << "  Theory, split-block:         "
+              << theoretical_fpr_blocked(NUM_KEYS, sizing.block_count()) * 100 << "%\n";
+    std::cout << "  Theory, classic (same m, k): "
+              << theoretical_fpr_classic(NUM_KEYS, sizing.bits(), BlockedBloomFilter::WORDS) * 100
+              << "%\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• One cache line per key: a query is a single (prefetchable) miss\n";
+    std::cout << "• Inserts skip the RMW when the bit is already set - hot blocks stay shared\n";
+    std::cout << "• Lookups are plain loads: readers never invalidate each other's lines\n";
+    std::cout << "• Batching overlaps the misses of 16 keys; SIMD builds all 8 masks at once\n";
+    std::cout << "• Price of blocking: a slightly higher FPR than a classic filter\n";
+
+    return 0;
+}
@@ -0,0 +1,283 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <list>
+#include <memory>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+#include "zipf.hpp"
+
+// Concurrent CLOCK (second-chance) cache
+// An LRU cache must move the entry to the list head on EVERY hit, so every
+// reader takes the lock. CLOCK approximates LRU with one reference bit per
+// frame instead:
+//   hit:   seqlock-validated loads of the frame + set ref = 1 (relaxed store,
+//          skipped if it is already set - hot frames are never written)
+//   miss:  the hand sweeps the frames; a set ref bit buys the frame another
+//          round (cleared), a clear one is evicted and reused
+// The key → frame index is a lossy, set-associative table of hints. Every
+// hint is validated against the frame's own key, so stale hints left behind
+// by evictions are harmless and nothing has to be removed from the index.
+// Keys are uint32_t < UINT32_MAX, values are 64-bit (a handle or small
+// decoded object).
+
+class ClockCache {
+public:
+    explicit ClockCache(size_t capacity)
+        : num_frames(capacity), frames(new Frame[capacity]),
+          bucket_mask(round_up_pow2(std::max<size_t>(1, capacity / 2)) - 1),
+          buckets(new Bucket[bucket_mask + 1]) {}
+
+    ClockCache(const ClockCache&) = delete;
+    ClockCache& operator=(const ClockCache&) = delete;
+
+    bool get(uint32_t key, uint64_t& out) {
+        Bucket& b = buckets[bucket_of(key)];
+        for (auto& hint : b.entries) {
+            const uint64_t e = hint.load(std::memory_order_relaxed);
+            if (hint_key(e) != key) continue;
+            Frame& f = frames[hint_frame(e)];
+            if (read_frame(f, key, out)) {
+                if (!f.ref.load(std::memory_order_relaxed))
+                    f.ref.store(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Called after a miss. Concurrent misses on the same key may both insert;
+    // the loser's frame is unreachable and simply ages out.
+    void put(uint32_t key, uint64_t value) {
+        const size_t f = evict_frame();
+        Frame& frame = frames[f];
+        frame.key.store(key, std::memory_order_relaxed);
+        frame.value.store(value, std::memory_order_relaxed);
+        frame.ref.store(0, std::memory_order_relaxed);  // Must be hit again to survive a sweep
+        frame.version.fetch_add(1, std::memory_order_release);  // Odd → even: published
+        publish_hint(key, f);
+    }
+
+    size_t capacity() const { return num_frames; }
+
+private:
+    static constexpr uint32_t NO_KEY = UINT32_MAX;
+    static constexpr int WAYS = 8;
+
+    struct alignas(32) Frame {
+        std::atomic<uint32_t> version{0};  // Seqlock: odd while being rewritten
+        std::atomic<uint32_t> key{NO_KEY};
+        std::atomic<uint64_t> value{0};
+        std::atomic<uint8_t> ref{0};
+    };
+
+    // One cache line of hints: (key + 1) << 32 | frame, 0 = empty
+    struct alignas(64) Bucket {
+        std::atomic<uint64_t> entries[WAYS] = {};
+    };
+
+    const size_t num_frames;
+    std::unique_ptr<Frame[]> frames;
+    const size_t bucket_mask;
+    std::unique_ptr<Bucket[]> buckets;
+    alignas(64) std::atomic<size_t> hand{0};
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    size_t bucket_of(uint32_t key) const {
+        return (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull >> 32) & bucket_mask;
+    }
+
+    static uint64_t make_hint(uint32_t key, size_t frame) {
+        return (static_cast<uint64_t>(key) + 1) << 32 | frame;
+    }
+    static uint32_t hint_key(uint64_t e) { return static_cast<uint32_t>(e >> 32) - 1; }
+    static size_t hint_frame(uint64_t e) { return static_cast<uint32_t>(e); }
+
+    static bool read_frame(const Frame& f, uint32_t key, uint64_t& out) {
+        const uint32_t v1 = f.version.load(std::memory_order_acquire);
+        if (v1 & 1) return false;  // Being replaced: treat as a miss
+        const uint32_t k = f.key.load(std::memory_order_relaxed);
+        const uint64_t val = f.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (k != key || f.version.load(std::memory_order_relaxed) != v1) return false;
+        out = val;
+        return true;
+    }
+
+    // Sweep until a frame with a clear ref bit can be locked (version odd)
+    size_t evict_frame() {
+        while (true) {
+            const size_t f = hand.fetch_add(1, std::memory_order_relaxed) % num_frames;
+            Frame& frame = frames[f];
+            if (frame.ref.load(std::memory_order_relaxed)) {
+                frame.ref.store(0, std::memory_order_relaxed);  // Second chance
+                continue;
+            }
+            uint32_t v = frame.version.load(std::memory_order_relaxed);
+            if ((v & 1) == 0 &&
+                frame.version.compare_exchange_strong(v, v + 1, std::memory_order_acquire,
+                                                      std::memory_order_relaxed)) {
+                std::atomic_thread_fence(std::memory_order_release);  // Odd before new data
+                return f;
+            }
+        }
+    }
+
+    // Take the way that already names this key, else an empty one, else one
+    // whose frame was evicted, else overwrite (the displaced key just misses)
+    void publish_hint(uint32_t key, size_t frame) {
+        Bucket& b = buckets[bucket_of(key)];
+        int victim = static_cast<int>(frame % WAYS);
+        for (int w = 0; w < WAYS; ++w) {
+            const uint64_t e = b.entries[w].load(std::memory_order_relaxed);
+            if (e == 0 || hint_key(e) == key ||
+                frames[hint_frame(e)].key.load(std::memory_order_relaxed) != hint_key(e)) {
+                victim = w;
+                break;
+            }
+        }
+        b.entries[victim].store(make_hint(key, frame), std::memory_order_release);
+    }
+};
+
+// ============ BASELINE: mutex + std::list LRU ============
+class MutexLruCache {
+public:
+    explicit MutexLruCache(size_t capacity) : cap(capacity) { index.reserve(capacity); }
+
+    bool get(uint32_t key, uint64_t& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = index.find(key);
+        if (it == index.end()) return false;
+        order.splice(order.begin(), order, it->second);  // Hit → most recent
+        out = it->second->second;
+        return true;
+    }
+
+    void put(uint32_t key, uint64_t value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = index.find(key);
+        if (it != index.end()) {  // Another thread filled it first
+            it->second->second = value;
+            order.splice(order.begin(), order, it->second);
+            return;
+        }
+        if (order.size() == cap) {
+            index.erase(order.back().first);
+            order.pop_back();
+        }
+        order.emplace_front(key, value);
+        index.emplace(key, order.begin());
+    }
+
+private:
+    std::mutex mtx;
+    const size_t cap;
+    std::list<std::pair<uint32_t, uint64_t>> order;
+    std::unordered_map<uint32_t, std::list<std::pair<uint32_t, uint64_t>>::iterator> index;
+};
+
+// ============ BENCHMARK ============
+const size_t CACHE_SIZE = 1 << 16;  // 64K entries
+const uint64_t KEY_SPACE = 1 << 20;
+const int TOTAL_OPS = 4000000;
+
+uint64_t decode(uint32_t key) { return key * 0x2545F4914F6CDD1Dull; }  // The "expensive" load
+
+struct Result {
+    double mops;
+    double hit_ratio;
+    long wrong;
+};
+
+template <typename Cache>
+Result run(const ZipfGenerator& zipf, int num_threads) {
+    Cache cache(CACHE_SIZE);
+    std::vector<long> hits(num_threads, 0), wrong(num_threads, 0);
+    const int ops = TOTAL_OPS / num_threads;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            FastRandom rng(t + 1);
+            long h = 0, bad = 0;
+            uint64_t v;
+            for (int i = 0; i < ops; ++i) {
+                // Scatter ranks so hot keys don't sit in neighbouring buckets
+                const uint32_t key = static_cast<uint32_t>(zipf.next(rng)) * 2654435761u;
+                if (cache.get(key, v)) {
+                    ++h;
+                    bad += v != decode(key);
+                } else {
+                    cache.put(key, decode(key));
+                }
+            }
+            hits[t] = h;
+            wrong[t] = bad;
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count());
+
+    Result r{double(ops) * num_threads / us, 0, 0};
+    long total_hits = 0;
+    for (int t = 0; t < num_threads; ++t) {
+        total_hits += hits[t];
+        r.wrong += wrong[t];
+    }
+    r.hit_ratio = double(total_hits) / (double(ops) * num_threads);
+    return r;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Concurrent CLOCK Cache vs Mutex LRU               ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Cache: " << CACHE_SIZE << " entries, key space " << KEY_SPACE << ", "
+              << TOTAL_OPS << " gets per run (miss → put)\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    const double skews[] = {0.99, 0.8};
+    for (double theta : skews) {
+        ZipfGenerator zipf(KEY_SPACE, theta);
+        std::cout << "Zipf θ = " << theta << "\n";
+        std::cout << "┌─────────┬──────────────┬──────────┬──────────────┬──────────┬────────┐\n";
+        std::cout << "│ Threads │ LRU Mops/s   │ LRU hit% │ CLOCK Mops/s │ CLK hit% │ Values │\n";
+        std::cout << "├─────────┼──────────────┼──────────┼──────────────┼──────────┼────────┤\n";
+        const int thread_counts[] = {1, 2, 4, 8, 16};
+        for (int n : thread_counts) {
+            Result lru = run<MutexLruCache>(zipf, n);
+            Result clock = run<ClockCache>(zipf, n);
+            const bool ok = lru.wrong == 0 && clock.wrong == 0;
+            std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << lru.mops << " │ "
+                      << std::setw(8) << lru.hit_ratio * 100 << " │ " << std::setw(12)
+                      << clock.mops << " │ " << std::setw(8) << clock.hit_ratio * 100 << " │ "
+                      << (ok ? "ok ✅" : "BAD ❌") << "  │\n";
+        }
+        std::cout << "└─────────┴──────────────┴──────────┴──────────────┴──────────┴────────┘\n\n";
+    }
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• LRU writes the list on every hit, so even readers serialize on the lock\n";
+    std::cout << "• CLOCK hits are loads plus one relaxed store, and the store is skipped\n";
+    std::cout << "  when the bit is already set - the hottest frames stay read-only\n";
+    std::cout << "• One reference bit approximates recency well: hit ratios track LRU\n";
+    std::cout << "• Stale index hints are caught by the frame's seqlock + key check,\n";
+    std::cout << "  so eviction never has to touch the index\n";
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <string>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cstdio>
+#include <cstdint>
+#include "backoff.hpp"
+#include "cpu_time.hpp"
+#include "trace_ring.hpp"
+
+// Logging from inside a lock-free hot path
+// 09_cas_with_backoff.cpp's retry loop is exactly where we'd like to know
+// what happened, and exactly where a lock or std::cout would change the
+// answer. Compared here:
+//   - no logging
+//   - trace_ring.hpp: per-thread SPSC ring, binary record, formatted later
+//   - the naive way: snprintf + append to a shared buffer under a mutex
+
+// Formats every event (so the drainer does the real work) but keeps nothing
+TraceDrainer::Sink discard_sink() {
+    return [](const TraceEvent& e) {
+        char msg[128];
+        format_trace(e, msg, sizeof(msg));
+    };
+}
+
+// ============ TEST 1: COST PER RECORD ============
+const int RECORDS_PER_THREAD = 2000000;
+
+// The timestamp is part of every record. rdtsc is ~20 cycles on bare metal
+// but can trap to the hypervisor in a VM, so it is reported separately.
+// Records are ordered by timestamp, so also count readings that went back.
+double rdtsc_cost_ns(long& backwards) {
+    backwards = 0;
+    uint64_t prev = read_tsc();
+    double start = thread_cpu_ns();
+    for (int i = 0; i < RECORDS_PER_THREAD; ++i) {
+        const uint64_t now = read_tsc();
+        backwards += now < prev;
+        prev = now;
+    }
+    double ns = thread_cpu_ns() - start;
+    return ns / RECORDS_PER_THREAD;
+}
+
+double record_cost_ns(int num_threads, uint64_t& delivered, uint64_t& lost) {
+    TraceDrainer drainer(discard_sink());
+    std::vector<double> ns(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            trace("thread %llu up", t);  // Takes the ring outside the timed loop
+            double start = thread_cpu_ns();
+            for (int i = 0; i < RECORDS_PER_THREAD; ++i)
+                trace("iteration %llu of thread %llu", i, t);
+            ns[t] = (thread_cpu_ns() - start) / RECORDS_PER_THREAD;
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    drainer.stop();
+    delivered = drainer.delivered();
+    lost = drainer.lost();
+    double sum = 0;
+    for (double v : ns) sum += v;
+    return sum / num_threads;
+}
+
+// ============ TEST 2: worker_with_backoff FROM 09 ============
+const int ITERATIONS = 100000;
+
+std::atomic<int> counter{0};
+
+struct NoLog {
+    void retry(int, int) {}
+    void done(int, int) {}
+};
+
+struct RingLog {
+    void retry(int old, int attempt) { trace("cas retry old=%llu attempt=%llu", old, attempt); }
+    void done(int value, int attempts) { trace("cas done value=%llu retries=%llu", value, attempts); }
+};
+
+struct MutexLog {
+    std::mutex mtx;
+    std::string buffer;
+
+    void retry(int old, int attempt) { write("cas retry old=%d attempt=%d\n", old, attempt); }
+    void done(int value, int attempts) { write("cas done value=%d retries=%d\n", value, attempts); }
+
+    void write(const char* fmt, int a, int b) {
+        char line[64];
+        int n = std::snprintf(line, sizeof(line), fmt, a, b);
+        std::lock_guard<std::mutex> lock(mtx);
+        buffer.append(line, n);
+        if (buffer.size() > (1 << 20)) buffer.clear();  // Pretend it was written out
+    }
+};
+
+template <typename Log>
+void worker_with_backoff(Log& log, long& retries) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        int old = counter.load(std::memory_order_relaxed);
+        ExponentialBackoff<1, 64> backoff;
+        int attempt = 0;
+        while (!counter.compare_exchange_weak(old, old + 1, std::memory_order_relaxed,
+                                              std::memory_order_relaxed)) {
+            backoff.pause();
+            log.retry(old, ++attempt);
+            ++retries;
+        }
+        log.done(old + 1, attempt);
+    }
+}
+
+struct BackoffResult {
+    double mops;
+    long retries;
+};
+
+template <typename Log>
+BackoffResult run_backoff(Log& log, int num_threads) {
+    counter.store(0);
+    std::vector<long> retries(num_threads, 0);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+        threads.emplace_back([&, t] { worker_with_backoff(log, retries[t]); });
+    for (auto& th : threads)
+        th.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count());
+    long total = 0;
+    for (long r : retries) total += r;
+    return {double(ITERATIONS) * num_threads / us, total};
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Per-Thread Lossy Trace Rings                      ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Ring: " << TraceRing::RECORDS << " records x 32 bytes per thread, "
+              << "drained every 1 ms" << (TRACE_ENABLED ? "" : " (TRACE_ENABLED=0: no-op)")
+              << "\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    long tsc_backwards;
+    const double tsc_ns = rdtsc_cost_ns(tsc_backwards);
+    std::cout << "Test 1: trace() in a tight loop (" << RECORDS_PER_THREAD << " records/thread), "
+              << "rdtsc alone: " << tsc_ns << " ns, "
+              << (tsc_backwards == 0 ? "never went backwards ✅\n"
+                                     : std::to_string(tsc_backwards) + " steps backwards ❌\n");
+    std::cout << "┌─────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Threads │ ns/record    │ minus rdtsc  │ Delivered    │ Overwritten  │\n";
+    std::cout << "├─────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+    const int thread_counts[] = {1, 2, 4, 8};
+    for (int n : thread_counts) {
+        uint64_t delivered, lost;
+        double ns = record_cost_ns(n, delivered, lost);
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << ns << " │ "
+                  << std::setw(12) << ns - tsc_ns << " │ " << std::setw(12) << delivered << " │ "
+                  << std::setw(12) << lost << " │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n\n";
+
+    std::cout << "Test 2: 09's worker_with_backoff, a record per failed CAS and per increment"
+                 " - Mops/s\n";
+    std::cout << "┌─────────┬──────────────┬──────────────┬──────────┬──────────────┬──────────┐\n";
+    std::cout << "│ Threads │ No logging   │ Trace ring   │ Overhead │ Mutex+printf │ Overhead │\n";
+    std::cout << "├─────────┼──────────────┼──────────────┼──────────┼──────────────┼──────────┤\n";
+    long traced = 0;
+    uint64_t delivered = 0, lost = 0;
+    for (int n : thread_counts) {
+        NoLog none;
+        MutexLog locked;
+        RingLog ring;
+        BackoffResult base = run_backoff(none, n);
+        TraceDrainer drainer(discard_sink());
+        BackoffResult traced_run = run_backoff(ring, n);
+        drainer.stop();
+        BackoffResult mutexed = run_backoff(locked, n);
+        traced += traced_run.retries + long(ITERATIONS) * n;
+        delivered += drainer.delivered();
+        lost += drainer.lost();
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << base.mops << " │ "
+                  << std::setw(12) << traced_run.mops << " │ " << std::setw(7)
+                  << (base.mops / traced_run.mops - 1) * 100 << "% │ " << std::setw(12)
+                  << mutexed.mops << " │ " << std::setw(7) << (base.mops / mutexed.mops - 1) * 100
+                  << "% │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────────┴──────────┴──────────────┴──────────┘\n";
+    std::cout << "Records traced: " << traced << ", delivered: " << delivered
+              << ", overwritten: " << lost << "\n\n";
+
+    std::cout << "Sample drained output (formatted on the drainer thread):\n";
+    {
+        int shown = 0;
+        TraceDrainer drainer([&](const TraceEvent& e) {
+            if (shown++ < 4) print_trace_to(stdout)(e);
+        });
+        std::thread a([] { for (int i = 0; i < 2; ++i) trace("worker A step %llu, value %llx", i, 0xbeef + i); });
+        a.join();
+        std::thread b([] { for (int i = 0; i < 2; ++i) trace("worker B step %llu, value %llx", i, 0xcafe + i); });
+        b.join();
+        drainer.stop();
+        std::fflush(stdout);
+    }
+    std::cout << "\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• A record is 4 relaxed stores + 1 release store to the thread's own\n";
+    std::cout << "  ring: no RMW, no lock, no line shared with other producers\n";
+    std::cout << "• The cost is flat in the thread count - there is nothing to contend on\n";
+    std::cout << "• The timestamp dominates: the ring part is a few ns, rdtsc is ~20 cycles\n";
+    std::cout << "  natively (more under a hypervisor that traps it)\n";
+    std::cout << "• snprintf runs on the drainer; the hot path only stores a pointer\n";
+    std::cout << "• A slow drainer loses the OLDEST records instead of stalling producers\n";
+    std::cout << "• The mutex logger adds a second contended line to the very loop it watches\n";
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "cpu_time.hpp"
+#include "latency_histogram.hpp"
+#include "zipf.hpp"
+
+// Recording latency samples from many threads
+//   - MutexHistogram: the same log-linear buckets behind one std::mutex
+//   - LatencyHistogram: relaxed fetch_add into per-thread stripes
+//     (latency_histogram.hpp), merged only when someone takes a snapshot
+
+class MutexHistogram {
+public:
+    void record(uint64_t value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++counts[HistogramSnapshot::bucket(value)];
+        sum += value;
+        largest = std::max(largest, value);
+    }
+
+private:
+    std::mutex mtx;
+    uint64_t counts[HistogramSnapshot::BUCKETS] = {};
+    uint64_t sum = 0;
+    uint64_t largest = 0;
+};
+
+// Heavy-tailed fake latencies: mostly ~100-1000, occasionally 1000x that
+uint64_t fake_latency(FastRandom& rng) {
+    const double u = rng.next_double();
+    return static_cast<uint64_t>(100.0 / std::pow(1.0 - u * 0.999999, 0.7));
+}
+
+// ============ TEST 1: COST PER RECORD ============
+const int SAMPLES = 2000000;  // Split across threads
+
+struct RecordResult {
+    double ns_per_record;  // Thread CPU time, averaged over threads
+    double mrecords_per_sec;
+};
+
+template <typename Hist>
+RecordResult record_cost(Hist& hist, int num_threads) {
+    const int per_thread = SAMPLES / num_threads;
+    std::vector<double> ns(num_threads);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            FastRandom rng(t + 1);
+            uint64_t values[256];
+            for (auto& v : values) v = fake_latency(rng);
+            hist.record(values[0]);  // Stripe allocation outside the timed loop
+            double t0 = thread_cpu_ns();
+            for (int i = 0; i < per_thread; ++i)
+                hist.record(values[i & 255]);
+            ns[t] = (thread_cpu_ns() - t0) / per_thread;
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    double sum = 0;
+    for (double v : ns) sum += v;
+    return {sum / num_threads, double(per_thread) * num_threads / us};
+}
+
+// ============ TEST 2: PERCENTILE ACCURACY ============
+void accuracy() {
+    LatencyHistogram hist;
+    std::vector<uint64_t> exact;
+    FastRandom rng(7);
+    for (int i = 0; i < 1000000; ++i) {
+        uint64_t v = fake_latency(rng);
+        hist.record(v);
+        exact.push_back(v);
+    }
+    std::sort(exact.begin(), exact.end());
+    HistogramSnapshot s = hist.snapshot();
+
+    std::cout << "┌────────────┬──────────────┬──────────────┬──────────┐\n";
+    std::cout << "│ Percentile │ Exact        │ Histogram    │ Error    │\n";
+    std::cout << "├────────────┼──────────────┼──────────────┼──────────┤\n";
+    const double ps[] = {50, 90, 99, 99.9, 99.99, 100};
+    for (double p : ps) {
+        size_t k = std::min(exact.size() - 1, static_cast<size_t>(p / 100.0 * exact.size()));
+        uint64_t e = exact[k];
+        uint64_t h = s.percentile(p);
+        std::cout << "│ " << std::setw(10) << p << " │ " << std::setw(12) << e << " │ "
+                  << std::setw(12) << h << " │ " << std::setw(7)
+                  << (static_cast<double>(h) - e) / e * 100 << "% │\n";
+    }
+    std::cout << "└────────────┴──────────────┴──────────────┴──────────┘\n";
+    std::cout << "Mean (from the running sum, exact): " << s.mean() << ", "
+              << HistogramSnapshot::BUCKETS << " buckets per stripe\n\n";
+}
+
+// ============ TEST 3: SNAPSHOT WHILE RECORDING ============
+double snapshot_us_under_load(int writers, bool& monotonic) {
+    LatencyHistogram hist;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < writers; ++t) {
+        threads.emplace_back([&, t] {
+            FastRandom rng(t + 1);
+            while (!stop.load(std::memory_order_relaxed))
+                for (int i = 0; i < 1000; ++i) hist.record(fake_latency(rng));
+        });
+    }
+    const int snaps = 200;
+    uint64_t last = 0;
+    double ns = 0;
+    monotonic = true;
+    for (int i = 0; i < snaps; ++i) {
+        double t0 = thread_cpu_ns();  // Our own time only, not the writers'
+        uint64_t c = hist.snapshot().count();
+        ns += thread_cpu_ns() - t0;
+        monotonic &= c >= last;
+        last = c;
+        std::this_thread::yield();  // Let writers run between snapshots
+    }
+    stop.store(true);
+    for (auto& th : threads)
+        th.join();
+    return ns / snaps / 1000;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Lock-Free Concurrent Latency Histogram            ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Test 1: record() from N threads (" << SAMPLES << " samples total)\n";
+    std::cout << "┌─────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│         │ Mutex        │ Mutex        │ Striped      │ Striped      │\n";
+    std::cout << "│ Threads │ ns/record    │ Mrec/s       │ ns/record    │ Mrec/s       │\n";
+    std::cout << "├─────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+    const int thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    for (int n : thread_counts) {
+        MutexHistogram locked;
+        LatencyHistogram striped;
+        RecordResult m = record_cost(locked, n);
+        RecordResult s = record_cost(striped, n);
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << m.ns_per_record << " │ "
+                  << std::setw(12) << m.mrecords_per_sec << " │ " << std::setw(12)
+                  << s.ns_per_record << " │ " << std::setw(12) << s.mrecords_per_sec << " │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n\n";
+
+    std::cout << "Test 2: percentiles vs exact (1M heavy-tailed samples)\n";
+    accuracy();
+
+    std::cout << "Test 3: snapshot() while writers keep recording\n";
+    const int writer_counts[] = {1, 4, 16};
+    for (int w : writer_counts) {
+        bool monotonic;
+        double us = snapshot_us_under_load(w, monotonic);
+        std::cout << "  " << std::setw(2) << w << " writers: " << std::setw(8) << us
+                  << " µs per snapshot, counts never went backwards: "
+                  << (monotonic ? "yes ✅" : "NO ❌") << "\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• The mutex histogram makes every sample a lock handoff between threads\n";
+    std::cout << "• Striped buckets: each thread's fetch_adds hit its own lines only\n";
+    std::cout << "• Log-linear buckets bound the error (~3%) from 1 ns to hours\n";
+    std::cout << "• Snapshots read while writers run - no lock, no pause in recording\n";
+    std::cout << "• 09_cas_with_backoff --sweep uses it for its p50/p99/p99.9 columns\n";
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <shared_mutex>
+#include <unordered_map>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+#include "left_right.hpp"
+#include "zipf.hpp"
+
+// Left-Right: wrap a plain single-threaded structure, get wait-free reads
+//   Part 1: 03_atomic_broken.cpp's x/y pair - two atomics vs LeftRight<Pair>
+//   Part 2: std::unordered_map lookups under a steady stream of updates,
+//           LeftRight vs std::shared_mutex
+
+// ============ PART 1: THE x/y PAIR ============
+const auto PAIR_TIME = std::chrono::milliseconds(100);
+
+struct Pair {
+    int x = 0;
+    int y = 0;
+};
+
+struct PairResult {
+    long reads;
+    long inconsistent;
+};
+
+// 03's version: each field is atomic, the pair is not
+PairResult separate_atomics() {
+    std::atomic<int> x{0}, y{0};
+    std::atomic<bool> done{false};
+    PairResult r{0, 0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            int vx = x.load(std::memory_order_relaxed);
+            int vy = y.load(std::memory_order_relaxed);
+            r.inconsistent += vx != vy;
+            ++r.reads;
+        }
+    });
+    const auto deadline = std::chrono::steady_clock::now() + PAIR_TIME;
+    for (int i = 1; std::chrono::steady_clock::now() < deadline; ++i) {
+        x.store(i, std::memory_order_relaxed);
+        y.store(i, std::memory_order_relaxed);
+    }
+    done.store(true);
+    reader.join();
+    return r;
+}
+
+PairResult left_right_pair() {
+    LeftRight<Pair> pair;
+    std::atomic<bool> done{false};
+    PairResult r{0, 0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            bool ok = pair.read([](const Pair& p) { return p.x == p.y; });
+            r.inconsistent += !ok;
+            ++r.reads;
+        }
+    });
+    const auto deadline = std::chrono::steady_clock::now() + PAIR_TIME;
+    for (int i = 1; std::chrono::steady_clock::now() < deadline; ++i)
+        pair.modify([i](Pair& p) {
+            p.x = i;
+            p.y = i;
+        });
+    done.store(true);
+    reader.join();
+    return r;
+}
+
+// ============ PART 2: MAP WORKLOAD ============
+const int KEYS = 100000;
+const auto RUN_TIME = std::chrono::milliseconds(200);
+const auto WRITE_INTERVAL = std::chrono::microseconds(20);
+
+using Map = std::unordered_map<int, long>;
+
+Map make_map() {
+    Map m;
+    for (int k = 0; k < KEYS; ++k) m[k] = k;
+    return m;
+}
+
+class RwLockMap {
+private:
+    mutable std::shared_mutex mtx;
+    Map map = make_map();
+
+public:
+    long find(int key) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return map.find(key)->second;
+    }
+
+    void update(int key, long value) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        map[key] = value;
+    }
+};
+
+class LeftRightMap {
+private:
+    LeftRight<Map> map{make_map()};
+
+public:
+    long find(int key) const {
+        return map.read([key](const Map& m) { return m.find(key)->second; });
+    }
+
+    void update(int key, long value) {
+        map.modify([=](Map& m) { m[key] = value; });
+    }
+};
+
+struct MapResult {
+    double mreads_per_sec;
+    long writes;
+    long bad;  // Values must always be key + (a multiple of KEYS)
+};
+
+template <typename M>
+MapResult run_map(int num_readers) {
+    M map;
+    std::vector<long> reads(num_readers, 0), bad(num_readers, 0);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + RUN_TIME;
+
+    // Readers watch the clock themselves: a writer-starving lock must not
+    // keep the benchmark running forever
+    std::vector<std::thread> readers;
+    for (int i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&, i] {
+            FastRandom rng(i + 1);
+            long n = 0, errors = 0;
+            do {
+                for (int k = 0; k < 256; ++k) {
+                    int key = static_cast<int>(rng.next(KEYS));
+                    errors += map.find(key) % KEYS != key;
+                    ++n;
+                }
+            } while (std::chrono::steady_clock::now() < deadline);
+            reads[i] = n;
+            bad[i] = errors;
+        });
+    }
+
+    FastRandom rng(999);
+    long writes = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        int key = static_cast<int>(rng.next(KEYS));
+        map.update(key, key + long(KEYS) * ++writes);
+        std::this_thread::sleep_for(WRITE_INTERVAL);
+    }
+    for (auto& t : readers)
+        t.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    MapResult r{0, writes, 0};
+    long total = 0;
+    for (int i = 0; i < num_readers; ++i) {
+        total += reads[i];
+        r.bad += bad[i];
+    }
+    r.mreads_per_sec = total / us;
+    return r;
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Left-Right: Wait-Free Reads of Any Structure      ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Part 1: x/y pair (03_atomic_broken.cpp), 1 writer setting x = y = i for "
+              << PAIR_TIME.count() << " ms\n";
+    PairResult a = separate_atomics();
+    PairResult lr = left_right_pair();
+    std::cout << "┌──────────────────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Pair                     │ Reads        │ x != y seen  │\n";
+    std::cout << "├──────────────────────────┼──────────────┼──────────────┤\n";
+    std::cout << "│ Two std::atomic<int>     │ " << std::setw(12) << a.reads << " │ "
+              << std::setw(12) << a.inconsistent << " │\n";
+    std::cout << "│ LeftRight<Pair>          │ " << std::setw(12) << lr.reads << " │ "
+              << std::setw(12) << lr.inconsistent << " │\n";
+    std::cout << "└──────────────────────────┴──────────────┴──────────────┘\n";
+    std::cout << (lr.inconsistent == 0 ? "✅ LeftRight readers never saw a half-written pair\n\n"
+                                       : "❌ LeftRight readers saw a torn pair\n\n");
+
+    std::cout << "Part 2: std::unordered_map (" << KEYS << " keys), 1 writer updating every "
+              << WRITE_INTERVAL.count() << " µs, " << RUN_TIME.count() << " ms per run\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "┌─────────┬──────────────┬──────────┬──────────────┬──────────┬────────┐\n";
+    std::cout << "│ Readers │ shared_mutex │ writes   │ Left-Right   │ writes   │ Values │\n";
+    std::cout << "│         │ Mreads/s     │          │ Mreads/s     │          │        │\n";
+    std::cout << "├─────────┼──────────────┼──────────┼──────────────┼──────────┼────────┤\n";
+    const int reader_counts[] = {1, 2, 4, 8, 16};
+    for (int n : reader_counts) {
+        MapResult rw = run_map<RwLockMap>(n);
+        MapResult left = run_map<LeftRightMap>(n);
+        const bool ok = rw.bad == 0 && left.bad == 0;
+        std::cout << "│ " << std::setw(7) << n << " │ " << std::setw(12) << rw.mreads_per_sec
+                  << " │ " << std::setw(8) << rw.writes << " │ " << std::setw(12)
+                  << left.mreads_per_sec << " │ " << std::setw(8) << left.writes << " │ "
+                  << (ok ? "ok ✅" : "BAD ❌") << "  │\n";
+    }
+    std::cout << "└─────────┴──────────────┴──────────┴──────────────┴──────────┴────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• Readers store to their own indicator slot - no shared RMW, no retry,\n";
+    std::cout << "  so every read finishes in a bounded number of steps (wait-free)\n";
+    std::cout << "• shared_mutex readers all RMW one lock word, and a writer waits for\n";
+    std::cout << "  (or starves behind) them\n";
+    std::cout << "• The price: 2x memory, every update runs twice, and writers wait for\n";
+    std::cout << "  readers to drain (membarrier makes that wait the writer's cost only)\n";
+    std::cout << "• Unlike RCU nothing is copied or freed per update - any structure works\n";
+
+    return 0;
+}
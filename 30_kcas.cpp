@@ -0,0 +1,182 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+#include "backoff.hpp"
+#include "kcas.hpp"
+#include "zipf.hpp"
+
+// Updating k words together: every operation picks k distinct words out of
+// a small shared pool and increments all of them as one atomic step.
+//   - one std::mutex around the pool
+//   - a seqlock (writers serialize on the sequence word, readers retry)
+//   - k-CAS (kcas.hpp): lock-free, no shared lock word at all
+// Invariant checked at the end: sum of all words == k x operations.
+
+const int POOL = 16;          // Small → operations overlap → contention
+const int TOTAL_OPS = 400000;  // Split across threads
+
+// Pick k distinct indices into the pool
+void pick(FastRandom& rng, int k, int* idx) {
+    for (int i = 0; i < k; ++i) {
+        bool dup;
+        do {
+            idx[i] = static_cast<int>(rng.next(POOL));
+            dup = false;
+            for (int j = 0; j < i; ++j) dup |= idx[j] == idx[i];
+        } while (dup);
+    }
+}
+
+// ============ BASELINES ============
+class MutexWords {
+private:
+    std::mutex mtx;
+    uint64_t words[POOL] = {};
+
+public:
+    void add_one(const int* idx, int k) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int i = 0; i < k; ++i) ++words[idx[i]];
+    }
+
+    uint64_t sum() {
+        std::lock_guard<std::mutex> lock(mtx);
+        uint64_t s = 0;
+        for (uint64_t w : words) s += w;
+        return s;
+    }
+};
+
+class SeqlockWords {
+private:
+    alignas(64) std::atomic<uint64_t> seq{0};  // Odd = writer inside
+    std::atomic<uint64_t> words[POOL] = {};
+
+public:
+    void add_one(const int* idx, int k) {
+        ExponentialBackoff<1, 64> backoff;
+        uint64_t s = seq.load(std::memory_order_relaxed);
+        while ((s & 1) || !seq.compare_exchange_weak(s, s + 1, std::memory_order_acquire,
+                                                     std::memory_order_relaxed)) {
+            backoff.pause();
+            s = seq.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);  // Odd before the data
+        for (int i = 0; i < k; ++i)
+            words[idx[i]].store(words[idx[i]].load(std::memory_order_relaxed) + 1,
+                                std::memory_order_relaxed);
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    // Reader side: retry until no writer overlapped
+    uint64_t sum() {
+        while (true) {
+            const uint64_t s1 = seq.load(std::memory_order_acquire);
+            if (s1 & 1) continue;
+            uint64_t total = 0;
+            for (auto& w : words) total += w.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == s1) return total;
+        }
+    }
+};
+
+class KCasWords {
+private:
+    KCasWord words[POOL];
+
+public:
+    void add_one(const int* idx, int k) {
+        KCasEntry e[KCasImpl::MAX_WORDS];
+        ExponentialBackoff<1, 64> backoff;
+        while (true) {
+            for (int i = 0; i < k; ++i) {
+                const uint64_t v = kcas_read(words[idx[i]]);
+                e[i] = {&words[idx[i]], v, v + 1};
+            }
+            if (kcas(e, k)) return;
+            backoff.pause();
+        }
+    }
+
+    uint64_t sum() {  // Quiescent only
+        uint64_t s = 0;
+        for (auto& w : words) s += kcas_read(w);
+        return s;
+    }
+};
+
+// ============ BENCHMARK ============
+struct Result {
+    double mops;
+    bool invariant;
+};
+
+template <typename Words>
+Result run(int k, int num_threads) {
+    Words words;
+    const int ops = TOTAL_OPS / num_threads;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            FastRandom rng(t + 1);
+            int idx[KCasImpl::MAX_WORDS];
+            for (int i = 0; i < ops; ++i) {
+                pick(rng, k, idx);
+                words.add_one(idx, k);
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count());
+    return {double(ops) * num_threads / us, words.sum() == uint64_t(k) * ops * num_threads};
+}
+
+int main() {
+    std::cout << "╔════════════════════════════════════════════════════╗\n";
+    std::cout << "║  Lock-Free Multi-Word CAS (k-CAS)                  ║\n";
+    std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+
+    std::cout << "Pool: " << POOL << " words, " << TOTAL_OPS
+              << " operations per run, each adds 1 to k distinct words\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Throughput in M updates/s\n";
+    std::cout << "┌────┬─────────┬──────────────┬──────────────┬──────────────┬───────────┐\n";
+    std::cout << "│ k  │ Threads │ Mutex        │ Seqlock      │ k-CAS        │ Invariant │\n";
+    std::cout << "├────┼─────────┼──────────────┼──────────────┼──────────────┼───────────┤\n";
+    const int ks[] = {2, 4, 8};
+    const int thread_counts[] = {1, 2, 4, 8};
+    for (int k : ks) {
+        for (int n : thread_counts) {
+            Result m = run<MutexWords>(k, n);
+            Result s = run<SeqlockWords>(k, n);
+            Result c = run<KCasWords>(k, n);
+            const bool ok = m.invariant && s.invariant && c.invariant;
+            std::cout << "│ " << std::setw(2) << k << " │ " << std::setw(7) << n << " │ "
+                      << std::setw(12) << m.mops << " │ " << std::setw(12) << s.mops << " │ "
+                      << std::setw(12) << c.mops << " │ " << (ok ? "  ok ✅" : "  BAD ❌")
+                      << "   │\n";
+        }
+    }
+    std::cout << "└────┴─────────┴──────────────┴──────────────┴──────────────┴───────────┘\n\n";
+
+    std::cout << "Key Observations:\n";
+    std::cout << "• k-CAS costs 3k+1 CASes and 1+k pooled descriptors per update; a lock\n";
+    std::cout << "  costs one RMW - on raw throughput the locks win, and the gap grows with k\n";
+    std::cout << "• What k-CAS buys is progress: a preempted thread mid-update is\n";
+    std::cout << "  finished by whoever runs into its descriptor, instead of holding a lock\n";
+    std::cout << "• Disjoint updates never touch a common word, so they don't serialize\n";
+    std::cout << "  on one lock line the way the mutex and the seqlock writers do\n";
+    std::cout << "• Seqlock writers are a spinlock; its strength is the retry-only reader\n";
+
+    return 0;
+}
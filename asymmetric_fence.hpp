@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Asymmetric fences
+// EBR and RCU readers announce themselves with a store and then need a full
+// fence before their first protected load (store→load ordering, the one
+// reordering x86 allows). That fence costs tens to hundreds of ns on every
+// read, while the side that needs it - a reclaimer scanning the slots - runs
+// rarely. membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED) moves the cost: the
+// kernel makes every running thread of this process execute a full barrier,
+// so readers only need to stop the COMPILER from reordering.
+//
+//     reader:  slot = epoch;  light_fence();  p = ptr.load();
+//     scanner: unlink(p);     heavy_fence();  scan slots...
+//
+// Falls back to seq_cst fences on both sides when membarrier is missing
+// (non-Linux, kernels before 4.14, seccomp) or when disabled.
+
+class AsymmetricFence {
+public:
+    // Reader side: hot path
+    static void light() {
+        if (enabled.load(std::memory_order_relaxed))
+            std::atomic_signal_fence(std::memory_order_seq_cst);  // Compiler only
+        else
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // Scanner side: rare, microseconds when membarrier is used
+    static void heavy() {
+#if defined(__linux__)
+        if (enabled.load(std::memory_order_relaxed)) {
+            syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+            return;
+        }
+#endif
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    static bool supported() { return available; }
+    static bool is_enabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // Only while no reader or scanner is running (benchmarks switch between
+    // runs): a reader using the old mode with a scanner using the new one
+    // would have no fence on either side.
+    static bool set_enabled(bool on) {
+        enabled.store(on && available, std::memory_order_relaxed);
+        return is_enabled();
+    }
+
+private:
+    static bool register_process() {
+#if defined(__linux__)
+        long cmds = syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+        if (cmds < 0 || !(cmds & MEMBARRIER_CMD_PRIVATE_EXPEDITED)) return false;
+        return syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+#else
+        return false;
+#endif
+    }
+
+    // Registered during static initialization, before main() starts threads
+    static inline const bool available = register_process();
+    static inline std::atomic<bool> enabled{available};
+};
+
+inline void light_fence() { AsymmetricFence::light(); }
+inline void heavy_fence() { AsymmetricFence::heavy(); }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include "backoff.hpp"
+
+// Two words that change together, in ONE atomic (x86-64 cmpxchg16b)
+// 03_atomic_broken.cpp splits an invariant over two atomics and loses it;
+// value + version, pointer + count and the x/y pair all fit in 16 bytes,
+// and a 16-byte CAS updates both halves at once:
+//
+//     AtomicPair<int64_t, uint64_t> p;                 // value, version
+//     p.update([](auto v) { return decltype(v){v.first + 1, v.second + 1}; });
+//     auto v = p.load();                               // never half-updated
+//
+// Built with -mcx16 (GCC/Clang define __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+// every operation is a `lock cmpxchg16b`. load() is one too: there is no
+// plain 16-byte atomic load on x86-64, so readers take the line exclusive
+// just like writers. Without 16-byte CAS the same API falls back to a tiny
+// spinlock and is_always_lock_free is false. We call the __sync builtins
+// directly: std::atomic<16-byte> goes through libatomic, which needs -latomic
+// and may pick a lock anyway.
+//
+// Comparison is bitwise, like std::atomic: each half occupies its own 8
+// bytes with zeroed padding, so equal values always have equal bits.
+
+template <typename A, typename B>
+class AtomicPair {
+    static_assert(sizeof(A) <= 8 && sizeof(B) <= 8, "each half must fit in 8 bytes");
+    static_assert(std::is_trivially_copyable<A>::value && std::is_trivially_copyable<B>::value,
+                  "halves must be trivially copyable");
+
+public:
+    struct Value {
+        A first;
+        B second;
+    };
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    static constexpr bool is_always_lock_free = true;
+#else
+    static constexpr bool is_always_lock_free = false;
+#endif
+
+    explicit AtomicPair(A a = A(), B b = B()) : bits(pack({a, b})) {}
+
+    AtomicPair(const AtomicPair&) = delete;
+    AtomicPair& operator=(const AtomicPair&) = delete;
+
+    Value load() const { return unpack(load_bits()); }
+
+    void store(Value v) {
+        Bits cur = load_bits();
+        while (!cas_bits(cur, pack(v))) {
+        }
+    }
+
+    // On failure `expected` receives the current value
+    bool compare_exchange(Value& expected, Value desired) {
+        Bits e = pack(expected);
+        if (cas_bits(e, pack(desired))) return true;
+        expected = unpack(e);
+        return false;
+    }
+
+    // Replace v with fn(v) atomically; fn may run more than once. Returns the
+    // value installed.
+    template <typename F>
+    Value update(F&& fn) {
+        Bits cur = load_bits();
+        while (true) {
+            const Value next = fn(unpack(cur));
+            if (cas_bits(cur, pack(next))) return next;
+        }
+    }
+
+private:
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    using Bits = unsigned __int128;
+
+    alignas(16) mutable Bits bits;
+
+    // Full barrier, like every __sync builtin
+    bool cas_bits(Bits& expected, Bits desired) const {
+        const Bits seen = __sync_val_compare_and_swap(&bits, expected, desired);
+        if (seen == expected) return true;
+        expected = seen;
+        return false;
+    }
+
+    // CAS that never changes anything: swaps 0 for 0 or fails and reports
+    Bits load_bits() const { return __sync_val_compare_and_swap(&bits, Bits(0), Bits(0)); }
+#else
+    struct Bits {
+        unsigned char b[16];
+        bool operator==(const Bits& o) const { return std::memcmp(b, o.b, 16) == 0; }
+    };
+
+    mutable std::atomic<bool> locked{false};
+    Bits bits;
+
+    void lock() const {
+        while (locked.exchange(true, std::memory_order_acquire))
+            while (locked.load(std::memory_order_relaxed)) cpu_relax();
+    }
+    void unlock() const { locked.store(false, std::memory_order_release); }
+
+    bool cas_bits(Bits& expected, Bits desired) {
+        lock();
+        const bool ok = bits == expected;
+        if (ok) bits = desired;
+        else expected = bits;
+        unlock();
+        return ok;
+    }
+
+    Bits load_bits() const {
+        lock();
+        Bits b = bits;
+        unlock();
+        return b;
+    }
+#endif
+
+    static Bits pack(const Value& v) {
+        unsigned char raw[16] = {};
+        std::memcpy(raw, &v.first, sizeof(A));
+        std::memcpy(raw + 8, &v.second, sizeof(B));
+        Bits b;
+        std::memcpy(&b, raw, 16);
+        return b;
+    }
+
+    static Value unpack(const Bits& b) {
+        unsigned char raw[16];
+        std::memcpy(raw, &b, 16);
+        Value v;
+        std::memcpy(&v.first, raw, sizeof(A));
+        std::memcpy(&v.second, raw + 8, sizeof(B));
+        return v;
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <cstdint>
+#include <cassert>
+
+// Lock-free atomic reference-counted pointer (split reference counts)
+// libstdc++'s std::atomic<std::shared_ptr<T>> guards every load with a spin
+// lock bit in the pointer. Here the atomic word packs the pointer (low 48
+// bits) with an EXTERNAL count (high 16 bits), and the control block keeps
+// the INTERNAL count (Williams, "C++ Concurrency in Action", 7.2.4):
+//
+//   load:     fetch_add(external + 1)   → that increment IS our reference;
+//                                         dropping it later decrements the
+//                                         internal count like any other ref
+//   replace:  old = exchange(new, 0)    → internal += old.external - BIAS + 1
+//
+// While a block is installed the atomic's share of the internal count is
+// BIAS (> any external count), not 1: readers that already dropped their
+// reference have taken 1 each from it, and the external count not folded
+// yet pays that back when the word is replaced. So the internal count can't
+// reach zero while the block is installed, and a reference is never handed
+// back through the shared word: re-installing the same block (store() of a
+// loaded RefPtr, compare_exchange back to it) starts a new external count
+// that no earlier reader can touch. When the external count gets large a
+// loader folds it into the internal count with a CAS of the word onto
+// itself, so it never overflows 16 bits.
+//
+// Every operation is one or two RMWs, no locks. Pointers must fit in 48
+// bits (x86-64 without 5-level paging, aarch64 with 48-bit VA).
+//
+//     AtomicRefPtr<Config> current(make_ref<Config>(...));
+//     RefPtr<Config> snap = current.load();      // reader
+//     current.store(make_ref<Config>(...));      // writer
+
+template <typename T>
+class AtomicRefPtr;
+
+template <typename T>
+class RefPtr {
+public:
+    RefPtr() = default;
+    RefPtr(const RefPtr& o) : cb(o.cb) { if (cb) cb->refs.fetch_add(1, std::memory_order_relaxed); }
+    RefPtr(RefPtr&& o) noexcept : cb(o.cb) { o.cb = nullptr; }
+    ~RefPtr() { release(cb); }
+
+    RefPtr& operator=(RefPtr o) noexcept {
+        std::swap(cb, o.cb);
+        return *this;
+    }
+
+    T* get() const { return cb ? &cb->value : nullptr; }
+    T& operator*() const { return cb->value; }
+    T* operator->() const { return &cb->value; }
+    explicit operator bool() const { return cb != nullptr; }
+    bool operator==(const RefPtr& o) const { return cb == o.cb; }
+    bool operator!=(const RefPtr& o) const { return cb != o.cb; }
+
+    template <typename U, typename... Args>
+    friend RefPtr<U> make_ref(Args&&... args);
+    friend class AtomicRefPtr<T>;
+
+private:
+    struct ControlBlock {
+        std::atomic<int64_t> refs{1};
+        T value;
+
+        template <typename... Args>
+        explicit ControlBlock(Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+
+    ControlBlock* cb = nullptr;
+
+    explicit RefPtr(ControlBlock* adopt) : cb(adopt) {}  // Takes over one reference
+
+    static void add(ControlBlock* c, int64_t n) {
+        if (!c || n == 0) return;
+        if (c->refs.fetch_add(n, std::memory_order_acq_rel) + n == 0) delete c;
+    }
+
+    static void release(ControlBlock* c) { add(c, -1); }
+
+    ControlBlock* detach() {
+        ControlBlock* c = cb;
+        cb = nullptr;
+        return c;
+    }
+};
+
+template <typename T, typename... Args>
+RefPtr<T> make_ref(Args&&... args) {
+    return RefPtr<T>(new typename RefPtr<T>::ControlBlock(std::forward<Args>(args)...));
+}
+
+template <typename T>
+class AtomicRefPtr {
+    using ControlBlock = typename RefPtr<T>::ControlBlock;
+
+    static constexpr int PTR_BITS = 48;
+    static constexpr uint64_t PTR_MASK = (uint64_t(1) << PTR_BITS) - 1;
+    static constexpr uint64_t ONE_EXTERNAL = uint64_t(1) << PTR_BITS;
+    static constexpr int64_t BIAS = int64_t(1) << 16;     // > any external count
+    static constexpr int64_t FOLD_AT = int64_t(1) << 15;  // Headroom for racing loaders
+
+    static ControlBlock* ptr(uint64_t word) { return reinterpret_cast<ControlBlock*>(word & PTR_MASK); }
+    static int64_t external(uint64_t word) { return static_cast<int64_t>(word >> PTR_BITS); }
+
+    // Turn the caller's reference into the atomic's BIAS share
+    static uint64_t install(ControlBlock* c) {
+        uint64_t raw = reinterpret_cast<uint64_t>(c);
+        assert((raw & ~PTR_MASK) == 0 && "pointer wider than 48 bits");
+        RefPtr<T>::add(c, BIAS - 1);
+        return raw;
+    }
+
+public:
+    AtomicRefPtr() = default;
+    explicit AtomicRefPtr(RefPtr<T> initial) : word(install(initial.detach())) {}
+    ~AtomicRefPtr() { settle(word.load(std::memory_order_relaxed)); }  // Drops the last share
+
+    AtomicRefPtr(const AtomicRefPtr&) = delete;
+    AtomicRefPtr& operator=(const AtomicRefPtr&) = delete;
+
+    static constexpr bool is_always_lock_free = std::atomic<uint64_t>::is_always_lock_free;
+
+    RefPtr<T> load() const {
+        const uint64_t ticket = word.fetch_add(ONE_EXTERNAL, std::memory_order_acquire);
+        if (external(ticket) + 1 >= FOLD_AT) fold(ticket + ONE_EXTERNAL);
+        return RefPtr<T>(ptr(ticket));  // Adopts the reference we just took
+    }
+
+    RefPtr<T> exchange(RefPtr<T> desired) {
+        const uint64_t old = word.exchange(install(desired.detach()), std::memory_order_acq_rel);
+        return settle(old);
+    }
+
+    void store(RefPtr<T> desired) { exchange(std::move(desired)); }
+
+    // On failure `expected` is refreshed with the current value
+    bool compare_exchange(RefPtr<T>& expected, RefPtr<T> desired) {
+        ControlBlock* want = expected.cb;
+        const uint64_t fresh = install(desired.cb);  // Before it's visible: see BIAS
+        uint64_t cur = word.load(std::memory_order_relaxed);
+        while (ptr(cur) == want) {
+            // Any external count is fine: settle() folds it
+            if (word.compare_exchange_weak(cur, fresh, std::memory_order_acq_rel,
+                                           std::memory_order_relaxed)) {
+                desired.detach();  // The atomic owns it now
+                settle(cur);       // Drops the atomic's reference to the old value
+                return true;
+            }
+        }
+        RefPtr<T>::add(desired.cb, 1 - BIAS);  // Never published: back to one ref
+        expected = load();
+        return false;
+    }
+
+private:
+    mutable std::atomic<uint64_t> word{0};
+
+    // Same block stays installed: move the external count into the internal one
+    void fold(uint64_t cur) const {
+        while (external(cur) >= FOLD_AT) {
+            if (word.compare_exchange_weak(cur, cur & PTR_MASK, std::memory_order_acq_rel,
+                                           std::memory_order_relaxed)) {
+                RefPtr<T>::add(ptr(cur), external(cur));
+                return;
+            }
+        }
+    }
+
+    // The word was replaced: fold its external count and turn the BIAS share
+    // back into one reference, handed to the caller
+    static RefPtr<T> settle(uint64_t old) {
+        ControlBlock* c = ptr(old);
+        // Can't reach zero: the reference we return is still counted
+        if (c) c->refs.fetch_add(external(old) - BIAS + 1, std::memory_order_acq_rel);
+        return RefPtr<T>(c);
+    }
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <utility>
+#include "epoch_reclaim.hpp"
+
+// Single-writer atomic snapshot (Afek, Attiya, Dolev, Gafni, Merritt &
+// Shavit, "Atomic Snapshots of Shared Memory", 1993)
+// N registers, register i written only by worker i. scan() returns all N
+// values as they were at ONE instant, without stopping the workers:
+//
+//     AtomicSnapshot<uint64_t> status(workers);
+//     status.update(id, STATE_BUSY);               // worker `id` only
+//     std::vector<uint64_t> view = status.scan();  // monitor, any thread
+//
+// A register holds a pointer to an immutable Record {value, view}; a new
+// record per update, so the pointer doubles as the register's version:
+//   scan:   collect every pointer twice; identical collects → nothing moved
+//           in between, return those values. Otherwise retry; once some
+//           register has moved TWICE since we started, its writer ran a
+//           whole scan inside ours, so return the view it embedded
+//   update: scan(), then publish {value, that view} - every update
+//           helps every future scanner finish
+// A scan therefore ends after at most N + 1 retries, however busy the
+// writers are (wait-free). Each update pays a scan and an N-value copy.
+// Old records are freed through EBR, so a pointer seen during a scan can't
+// be recycled into a "new" version before the scan ends.
+
+template <typename T>
+class AtomicSnapshot {
+public:
+    explicit AtomicSnapshot(int n, const T& initial = T())
+        : n(n), registers(new Register[n]) {
+        for (int i = 0; i < n; ++i)
+            registers[i].rec.store(new Record{initial, std::vector<T>(n, initial)},
+                                   std::memory_order_relaxed);
+    }
+
+    ~AtomicSnapshot() {
+        for (int i = 0; i < n; ++i) delete registers[i].rec.load(std::memory_order_relaxed);
+    }
+
+    AtomicSnapshot(const AtomicSnapshot&) = delete;
+    AtomicSnapshot& operator=(const AtomicSnapshot&) = delete;
+
+    int size() const { return n; }
+
+    // Register i must have a single writer
+    void update(int i, const T& value) {
+        EpochGuard guard;
+        std::vector<T> view;
+        scan(view);
+        Record* old = registers[i].rec.load(std::memory_order_relaxed);
+        registers[i].rec.store(new Record{value, std::move(view)}, std::memory_order_release);
+        epoch_retire(old);
+    }
+
+    void scan(std::vector<T>& out) const {
+        EpochGuard guard;
+        // Scratch reused across calls: scans run on every update
+        thread_local std::vector<Record*> a, b;
+        thread_local std::vector<char> moved;
+        a.resize(n);
+        b.resize(n);
+        moved.assign(n, 0);
+        collect(a);
+        while (true) {
+            collect(b);
+            bool same = true;
+            for (int j = 0; j < n; ++j) {
+                if (a[j] == b[j]) continue;
+                if (moved[j]) {
+                    out = b[j]->view;  // Borrow the view of a scan nested in ours
+                    return;
+                }
+                moved[j] = true;
+                same = false;
+            }
+            if (same) {
+                out.resize(n);
+                for (int j = 0; j < n; ++j) out[j] = b[j]->value;
+                return;
+            }
+            a.swap(b);
+        }
+    }
+
+    std::vector<T> scan() const {
+        std::vector<T> out;
+        scan(out);
+        return out;
+    }
+
+private:
+    struct Record {
+        T value;
+        std::vector<T> view;
+    };
+
+    struct alignas(64) Register {
+        std::atomic<Record*> rec{nullptr};
+    };
+
+    const int n;
+    std::unique_ptr<Register[]> registers;
+
+    void collect(std::vector<Record*>& into) const {
+        for (int j = 0; j < n; ++j) into[j] = registers[j].rec.load(std::memory_order_acquire);
+    }
+};
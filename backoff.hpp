@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Backoff policies for CAS retry loops
+// Extracted from worker_with_backoff in 09_cas_with_backoff.cpp so any CAS
+// loop can pick its strategy as a template parameter:
+//
+//     Backoff backoff;                     // one object per operation
+//     while (!v.compare_exchange_weak(old, old + 1)) {
+//         backoff.pause();                 // called after each failed CAS
+//     }
+//
+// Every policy is a small value type with an inline pause(). NoBackoff is an
+// empty struct whose pause() is empty, so the compiler emits exactly the same
+// loop as the hand-written "immediate retry" version.
+
+// One spin-wait hint to the CPU (what the inner loop of 09 used to inline)
+inline void cpu_relax() {
+#if defined(_MSC_VER)
+    _mm_pause();  // x86 intrinsic
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();  // GCC/Clang intrinsic
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+inline void cpu_relax(int n) {
+    for (int i = 0; i < n; ++i)
+        cpu_relax();
+}
+
+// Cycle counter for deadline-based waits. Falls back to steady_clock ticks
+// where there is no TSC; the policy only compares against its own readings.
+inline uint64_t read_tsc() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Immediate retry - hammers the cache line
+struct NoBackoff {
+    static constexpr const char* name = "None";
+    void pause() {}
+};
+
+// Same number of pauses after every failure
+template <int Pauses = 16>
+struct ConstantBackoff {
+    static constexpr const char* name = "Constant";
+    void pause() { cpu_relax(Pauses); }
+};
+
+// The original 09 strategy: start at Initial, double, cap at Cap
+template <int Initial = 1, int Cap = 64>
+struct ExponentialBackoff {
+    static constexpr const char* name = "Exponential";
+    int backoff = Initial;
+    void pause() {
+        cpu_relax(backoff);
+        backoff = std::min(backoff * 2, Cap);
+    }
+};
+
+// Exponential backoff with runtime parameters, for parameter sweeps where
+// one template instantiation per (cap, growth) pair would be unwieldy
+struct TunableBackoff {
+    static constexpr const char* name = "Tunable";
+    int backoff;
+    int cap;
+    int growth;
+
+    TunableBackoff(int initial, int cap_, int growth_)
+        : backoff(initial), cap(cap_), growth(growth_) {}
+
+    void pause() {
+        cpu_relax(backoff);
+        backoff = std::min(backoff * growth, cap);
+    }
+};
+
+// Exponential window, but wait a random amount inside it so threads that
+// failed together don't retry together
+template <int Initial = 1, int Cap = 64>
+struct JitteredBackoff {
+    static constexpr const char* name = "Exp + jitter";
+    int window = Initial;
+    uint32_t rng = seed();
+
+    void pause() {
+        // xorshift32: a few ALU ops, no shared state
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        cpu_relax(1 + static_cast<int>(rng % static_cast<uint32_t>(window)));
+        window = std::min(window * 2, Cap);
+    }
+
+private:
+    static uint32_t seed() {
+        thread_local uint32_t state =
+            static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+        return state += 0x9E3779B9u;
+    }
+};
+
+// Linear in the number of failures observed by this operation
+template <int PausesPerFailure = 4, int Cap = 256>
+struct ProportionalBackoff {
+    static constexpr const char* name = "Proportional";
+    int failures = 0;
+    void pause() {
+        ++failures;
+        cpu_relax(std::min(failures * PausesPerFailure, Cap));
+    }
+};
+
+// Wait until a TSC deadline instead of counting pauses: the delay is in
+// cycles, so it does not depend on how long `pause` takes on this CPU
+template <uint64_t InitialCycles = 64, uint64_t CapCycles = 4096>
+struct TscDeadlineBackoff {
+    static constexpr const char* name = "TSC deadline";
+    uint64_t cycles = InitialCycles;
+    void pause() {
+        const uint64_t deadline = read_tsc() + cycles;
+        while (read_tsc() < deadline)
+            cpu_relax();
+        cycles = std::min(cycles * 2, CapCycles);
+    }
+};
+
+// Generic CAS update: new = fn(old), retried with the chosen policy.
+// Returns the value that was replaced.
+template <typename Backoff, typename T, typename F>
+T cas_update(std::atomic<T>& target, F fn,
+             std::memory_order success = std::memory_order_relaxed,
+             std::memory_order failure = std::memory_order_relaxed) {
+    Backoff backoff;
+    T old = target.load(failure);
+    while (!target.compare_exchange_weak(old, fn(old), success, failure)) {
+        backoff.pause();
+    }
+    return old;
+}
+
+// Self-tuning exponential backoff
+// Each thread keeps a moving average of its CAS failure ratio (fixed point,
+// 1024 = every attempt failed). Every AdjustEvery operations the cap doubles
+// if the average is above HighWater and halves if it is below LowWater, so
+// the cap settles wherever failures stay inside the band - on any core
+// count, at any time of day. All state is thread-local: no shared writes.
+template <int MinCap = 1, int MaxCap = 4096,
+          int LowWater = 128, int HighWater = 512, int AdjustEvery = 256>
+struct AdaptiveBackoff {
+    static constexpr const char* name = "Adaptive";
+
+    struct State {
+        int cap = std::min(std::max(64, MinCap), MaxCap);  // Starts inside the bounds
+        int failure_ratio = 0;  // EWMA, alpha = 1/16
+        int operations = 0;
+    };
+
+    static State& state() {
+        thread_local State s;
+        return s;
+    }
+
+    State& s = state();
+    int backoff = 1;
+    int failures = 0;
+
+    void pause() {
+        cpu_relax(backoff);
+        backoff = std::min(backoff * 2, s.cap);
+        ++failures;
+    }
+
+    // The operation is over (CAS succeeded): fold its outcome into the average
+    ~AdaptiveBackoff() {
+        const int sample = failures * 1024 / (failures + 1);
+        s.failure_ratio += (sample - s.failure_ratio) / 16;
+        if (++s.operations == AdjustEvery) {
+            s.operations = 0;
+            if (s.failure_ratio > HighWater)
+                s.cap = std::min(s.cap * 2, MaxCap);
+            else if (s.failure_ratio < LowWater)
+                s.cap = std::max(s.cap / 2, MinCap);
+        }
+    }
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include "backoff.hpp"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Reusable thread barriers for phase-based workers
+//   CentralBarrier:       one shared counter + a sense flag; O(n) arrivals
+//                         on one cache line, O(1) flag everyone watches
+//   DisseminationBarrier: log2(n) rounds; in round r thread i signals
+//                         thread i + 2^r and waits for i - 2^r. No counter,
+//                         every flag has exactly one writer and one reader
+//   TournamentBarrier:    static binary tree; losers report to the winner
+//                         of their pair and wait, the champion wakes the tree
+//                         back up. n - 1 arrivals, log2(n) critical path
+// Every thread calls wait(id) with its own id in [0, n). Flags hold episode
+// numbers instead of a flipped bool, so a flag never has to be reset and a
+// fast thread already in the next episode can't confuse a slow one (the
+// classic sense reversal, with the whole count kept instead of its parity).
+//
+// BarrierWait::Spin spins, then keeps yielding; SpinThenPark spins and
+// yields briefly, then sleeps on a futex, so oversubscribed phases don't
+// burn the CPU the last arriver needs.
+
+enum class BarrierWait { Spin, SpinThenPark };
+
+// One-writer episode flag: set(e) publishes episode e, wait_reach(e) returns
+// once the flag is at e or later. Values are 31-bit and compared modulo 2^31;
+// bit 31 marks "someone is asleep on this word".
+class BarrierFlag {
+public:
+    void set(uint32_t episode) {
+        const uint32_t old = word.exchange(episode & VALUE_MASK, std::memory_order_release);
+        if (old & PARKED) wake_all();
+    }
+
+    void wait_reach(uint32_t episode, BarrierWait mode) const {
+        const int spin_limit = spin_rounds();
+        for (int spins = 0;; ++spins) {
+            uint32_t cur = word.load(std::memory_order_acquire);
+            if (reached(cur, episode)) return;
+            if (spins < spin_limit) {
+                cpu_relax();
+            } else if (mode == BarrierWait::Spin || spins < spin_limit + YIELDS) {
+                std::this_thread::yield();
+            } else {
+                // Announce the sleeper; the setter's exchange will see it
+                if (!(cur & PARKED) &&
+                    !word.compare_exchange_weak(cur, cur | PARKED, std::memory_order_relaxed))
+                    continue;
+                sleep_on(cur | PARKED);
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t PARKED = 0x80000000u;
+    static constexpr uint32_t VALUE_MASK = 0x7FFFFFFFu;
+    static constexpr int YIELDS = 4;  // Before parking
+
+    // On a single CPU the flag can't change while we spin
+    static int spin_rounds() {
+        static const int rounds = std::thread::hardware_concurrency() > 1 ? 128 : 0;
+        return rounds;
+    }
+
+    mutable std::atomic<uint32_t> word{0};
+
+    static bool reached(uint32_t cur, uint32_t episode) {
+        return ((cur - episode) & VALUE_MASK) < 0x40000000u;
+    }
+
+    void sleep_on(uint32_t expected) const {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected,
+                nullptr, nullptr, 0);
+#else
+        (void)expected;
+        std::this_thread::yield();
+#endif
+    }
+
+    void wake_all() {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX,
+                nullptr, nullptr, 0);
+#endif
+    }
+};
+
+// Keeps each flag (and each thread's episode count) on its own line
+struct alignas(64) PaddedFlag {
+    BarrierFlag flag;
+};
+
+struct alignas(64) PaddedEpisode {
+    uint32_t value = 0;  // Owned by one thread
+};
+
+class CentralBarrier {
+public:
+    explicit CentralBarrier(int n, BarrierWait mode = BarrierWait::Spin)
+        : parties(n), mode(mode), episodes(n), remaining(n) {}
+
+    void wait(int id) {
+        const uint32_t e = ++episodes[id].value;
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            remaining.store(parties, std::memory_order_relaxed);  // Before anyone can re-arrive
+            sense.set(e);
+        } else {
+            sense.wait_reach(e, mode);
+        }
+    }
+
+private:
+    const int parties;
+    const BarrierWait mode;
+    std::vector<PaddedEpisode> episodes;
+    alignas(64) std::atomic<int> remaining;
+    alignas(64) BarrierFlag sense;
+};
+
+class DisseminationBarrier {
+public:
+    explicit DisseminationBarrier(int n, BarrierWait mode = BarrierWait::Spin)
+        : parties(n), rounds(ceil_log2(n)), mode(mode), episodes(n),
+          flags(static_cast<size_t>(n) * rounds) {}
+
+    void wait(int id) {
+        const uint32_t e = ++episodes[id].value;
+        for (int r = 0; r < rounds; ++r) {
+            const int partner = (id + (1 << r)) % parties;
+            flags[partner * rounds + r].flag.set(e);
+            flags[id * rounds + r].flag.wait_reach(e, mode);
+        }
+    }
+
+private:
+    const int parties;
+    const int rounds;
+    const BarrierWait mode;
+    std::vector<PaddedEpisode> episodes;
+    std::vector<PaddedFlag> flags;  // [thread][round], written by thread - 2^round
+
+    static int ceil_log2(int n) {
+        int r = 0;
+        while ((1 << r) < n) ++r;
+        return r;
+    }
+};
+
+class TournamentBarrier {
+public:
+    explicit TournamentBarrier(int n, BarrierWait mode = BarrierWait::Spin)
+        : parties(n), rounds(ceil_log2(n)), mode(mode), episodes(n),
+          arrived(static_cast<size_t>(n) * std::max(rounds, 1)), wakeup(n) {}
+
+    void wait(int id) {
+        const uint32_t e = ++episodes[id].value;
+        // Arrival: win against partners id + 2^r until we lose (or are champion)
+        int r = 0;
+        for (; r < rounds; ++r) {
+            if (id & (1 << r)) {
+                const int winner = id - (1 << r);
+                arrived[winner * rounds + r].flag.set(e);
+                wakeup[id].flag.wait_reach(e, mode);
+                break;
+            }
+            const int loser = id + (1 << r);
+            if (loser < parties)  // Otherwise a bye
+                arrived[id * rounds + r].flag.wait_reach(e, mode);
+        }
+        // Wake-up: release everyone we beat, last round first
+        while (r-- > 0) {
+            const int loser = id + (1 << r);
+            if (loser < parties) wakeup[loser].flag.set(e);
+        }
+    }
+
+private:
+    const int parties;
+    const int rounds;
+    const BarrierWait mode;
+    std::vector<PaddedEpisode> episodes;
+    std::vector<PaddedFlag> arrived;  // [winner][round], written by that round's loser
+    std::vector<PaddedFlag> wakeup;   // [thread], written by the thread that beat it
+
+    static int ceil_log2(int n) {
+        int r = 0;
+        while ((1 << r) < n) ++r;
+        return r;
+    }
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+
+// Per-thread CAS instrumentation
+// Counting failed CAS attempts with a shared std::atomic adds a second
+// contended cache line to the very loop being measured. Instead each thread
+// gets its own cache-line-sized slot of plain counters; the slots are only
+// summed after join(), which already synchronizes with the workers.
+//
+// Compile with -DCAS_STATS_ENABLED=0 to turn every record call into a no-op:
+//     make CXXFLAGS="-std=c++17 -O2 -Wall -pthread -DCAS_STATS_ENABLED=0"
+
+#ifndef CAS_STATS_ENABLED
+#define CAS_STATS_ENABLED 1
+#endif
+
+struct alignas(64) CasCounters {
+    long successes = 0;
+    long failures = 0;
+
+    void on_success() {
+#if CAS_STATS_ENABLED
+        ++successes;
+#endif
+    }
+
+    void on_failure() {
+#if CAS_STATS_ENABLED
+        ++failures;
+#endif
+    }
+};
+
+class CasStats {
+private:
+    std::vector<CasCounters> slots;  // One per thread, never shares a line
+
+public:
+    static constexpr bool enabled = CAS_STATS_ENABLED != 0;
+
+    explicit CasStats(int num_threads) : slots(num_threads) {}
+
+    // Owned by thread `index` until it is joined
+    CasCounters& slot(int index) { return slots[index]; }
+
+    // Merge - call only after every worker has been joined
+    long successes() const {
+        long total = 0;
+        for (const auto& s : slots) total += s.successes;
+        return total;
+    }
+
+    long failures() const {
+        long total = 0;
+        for (const auto& s : slots) total += s.failures;
+        return total;
+    }
+
+    // Failed attempts per attempt, in [0, 1)
+    double failure_ratio() const {
+        long attempts = successes() + failures();
+        return attempts > 0 ? static_cast<double>(failures()) / attempts : 0.0;
+    }
+
+    void reset() {
+        for (auto& s : slots) s = CasCounters{};
+    }
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque
+// One owner thread pushes and pops at the BOTTOM; any number of thieves
+// steal from the TOP. The owner's fast path is a plain load/store of
+// `bottom` - no RMW - and only the race for the very last element (or a
+// thief against another thief) is settled with a CAS on `top`.
+//
+// Memory orderings follow Lê, Pop, Cohen & Zappa Nardelli, "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013):
+//
+//     push:  store item; fence(release); bottom = b + 1
+//     pop:   bottom = b - 1; fence(seq_cst); read top     (Dekker with steal)
+//     steal: read top; fence(seq_cst); read bottom; CAS top
+//
+// The circular array grows when full. Thieves may still be reading the old
+// array, so it is kept until the deque is destroyed (total garbage is less
+// than the final capacity).
+
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "items are read racily by thieves; store pointers or indices");
+
+public:
+    explicit ChaseLevDeque(int64_t initial_capacity = 1024)
+        : array(new Array(round_up(initial_capacity))) {
+        arrays.emplace_back(array.load(std::memory_order_relaxed));
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Owner only
+    void push(T item) {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1)
+            a = grow(a, t, b);
+        a->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only; LIFO end
+    bool pop(T& out) {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {  // Empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = a->get(b);
+        if (t == b) {  // Last item: race the thieves for it
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    enum class Steal { Success, Empty, Lost };
+
+    // Any thread; FIFO end. Lost = another thread took this item, retry is fine
+    Steal steal(T& out) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return Steal::Empty;
+        Array* a = array.load(std::memory_order_acquire);  // "consume" in the paper
+        T item = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+            return Steal::Lost;
+        out = item;
+        return Steal::Success;
+    }
+
+    // Racy estimate, for heuristics only
+    int64_t size() const {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    int64_t capacity() const { return array.load(std::memory_order_relaxed)->capacity; }
+
+private:
+    struct Array {
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> buffer;
+
+        explicit Array(int64_t cap)
+            : capacity(cap), mask(cap - 1), buffer(new std::atomic<T>[cap]) {}
+
+        // Relaxed: publication is ordered by the fences around bottom/top
+        T get(int64_t i) const { return buffer[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T x) { buffer[i & mask].store(x, std::memory_order_relaxed); }
+    };
+
+    static int64_t round_up(int64_t n) {
+        int64_t cap = 2;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    Array* grow(Array* old, int64_t t, int64_t b) {
+        Array* bigger = new Array(old->capacity * 2);
+        for (int64_t i = t; i < b; ++i)
+            bigger->put(i, old->get(i));
+        arrays.emplace_back(bigger);
+        array.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<int64_t> top{0};     // Written by thieves (CAS)
+    alignas(64) std::atomic<int64_t> bottom{0};  // Written by the owner only
+    alignas(64) std::atomic<Array*> array;
+    std::vector<std::unique_ptr<Array>> arrays;  // Owner only: current + retired
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <chrono>
+#include <ctime>
+
+// CPU time of the calling thread, in ns
+// The benchmarks run more threads than this machine may have cores; wall
+// time would charge a thread for the time it spent waiting to run, CPU time
+// only for what it did. Without CLOCK_THREAD_CPUTIME_ID (not POSIX) this
+// falls back to wall time.
+inline double thread_cpu_ns() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+#else
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
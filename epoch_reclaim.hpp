@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include "asymmetric_fence.hpp"
+
+// Epoch-based reclamation (EBR)
+// The answer to 06_lockfree_stack.cpp's "Memory reclamation issues
+// (simplified here with delete)": a node removed from a lock-free structure
+// may still be read by a thread that loaded its address just before the
+// removal. So instead of `delete`, the remover calls retire(), and the node
+// is freed only once every thread has left the epoch it could have seen it in.
+//
+//     {
+//         EpochGuard guard;            // pin: nodes we can reach stay alive
+//         Node* n = head.load(...);    // safe to dereference until scope ends
+//         ...unlink n with a CAS...
+//         epoch_retire(n);             // freed two epochs later
+//     }
+//
+// Readers pay one store + one light_fence() on entry and one store on exit;
+// no shared RMW. With membarrier available the entry fence is compiler-only
+// and try_advance() pays a heavy_fence() instead (asymmetric_fence.hpp).
+// Threads are registered on first use and released on exit.
+
+class EpochReclaimer {
+public:
+    static constexpr int MAX_THREADS = 256;
+    static constexpr uint64_t IDLE = ~0ull;
+    static constexpr size_t RETIRE_THRESHOLD = 64;  // Scan after this many retires
+
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    static EpochReclaimer& instance() {
+        static EpochReclaimer domain;
+        return domain;
+    }
+
+    void enter() {
+        ThreadState& ts = local();
+        if (ts.depth++ == 0) {
+            ts.slot->epoch.store(global_epoch.load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+            // The announcement must be visible before we read any shared pointer
+            light_fence();
+        }
+    }
+
+    void exit() {
+        ThreadState& ts = local();
+        if (--ts.depth == 0)
+            ts.slot->epoch.store(IDLE, std::memory_order_release);
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) {
+        ThreadState& ts = local();
+        ts.retired.push_back({ptr, deleter, global_epoch.load(std::memory_order_acquire)});
+        if (ts.retired.size() >= ts.scan_at) {
+            try_advance();
+            reclaim(ts.retired);
+            // If a stalled reader blocks the epoch, don't rescan on every retire
+            ts.scan_at = ts.retired.size() + RETIRE_THRESHOLD;
+        }
+    }
+
+    // Number of retired-but-not-yet-freed objects owned by this thread
+    size_t pending() { return local().retired.size(); }
+
+    ~EpochReclaimer() {
+        // Process exit: no readers remain
+        for (auto& r : orphans) r.deleter(r.ptr);
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{IDLE};
+        std::atomic<bool> in_use{false};
+    };
+
+    struct ThreadState {
+        Slot* slot = nullptr;
+        int depth = 0;
+        std::vector<Retired> retired;
+        size_t scan_at = RETIRE_THRESHOLD;
+
+        ~ThreadState() {
+            if (!slot) return;
+            EpochReclaimer& d = instance();
+            d.try_advance();
+            d.reclaim(retired);
+            if (!retired.empty()) {
+                // Still protected by someone: hand them to the domain
+                std::lock_guard<std::mutex> lock(d.orphans_mutex);
+                d.orphans.insert(d.orphans.end(), retired.begin(), retired.end());
+            }
+            slot->epoch.store(IDLE, std::memory_order_release);
+            slot->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    alignas(64) std::atomic<uint64_t> global_epoch{0};
+    alignas(64) std::atomic<int> high_water{0};  // Slots [0, high_water) may be in use
+    Slot slots[MAX_THREADS];
+    std::mutex orphans_mutex;                   // Thread exit only - never on the hot path
+    std::vector<Retired> orphans;
+
+    ThreadState& local() {
+        thread_local ThreadState ts;
+        if (!ts.slot) ts.slot = acquire_slot();
+        return ts;
+    }
+
+    Slot* acquire_slot() {
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            bool expected = false;
+            if (!slots[i].in_use.load(std::memory_order_relaxed) &&
+                slots[i].in_use.compare_exchange_strong(expected, true,
+                                                        std::memory_order_acq_rel)) {
+                int hw = high_water.load(std::memory_order_relaxed);
+                while (hw < i + 1 &&
+                       !high_water.compare_exchange_weak(hw, i + 1, std::memory_order_acq_rel)) {
+                }
+                return &slots[i];
+            }
+        }
+        std::terminate();  // More than MAX_THREADS live threads
+    }
+
+    // The epoch may advance once every pinned thread has seen the current one
+    void try_advance() {
+        uint64_t e = global_epoch.load(std::memory_order_acquire);
+        heavy_fence();  // Pairs with light_fence() in enter()
+        const int n = high_water.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i) {
+            uint64_t v = slots[i].epoch.load(std::memory_order_acquire);
+            if (v != IDLE && v != e)
+                return;  // Someone is still in an older epoch
+        }
+        global_epoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+    }
+
+    // Objects retired in epoch r are unreachable for anyone pinned at >= r + 1,
+    // and nobody can still be pinned below global - 1.
+    void reclaim(std::vector<Retired>& list) {
+        const uint64_t e = global_epoch.load(std::memory_order_acquire);
+        size_t kept = 0;
+        for (auto& r : list) {
+            if (r.epoch + 2 <= e)
+                r.deleter(r.ptr);
+            else
+                list[kept++] = r;
+        }
+        list.resize(kept);
+
+        std::unique_lock<std::mutex> lock(orphans_mutex, std::try_to_lock);
+        if (lock.owns_lock() && !orphans.empty()) {
+            kept = 0;
+            for (auto& r : orphans) {
+                if (r.epoch + 2 <= e)
+                    r.deleter(r.ptr);
+                else
+                    orphans[kept++] = r;
+            }
+            orphans.resize(kept);
+        }
+    }
+};
+
+// RAII read-side critical section
+struct EpochGuard {
+    EpochGuard() { EpochReclaimer::instance().enter(); }
+    ~EpochGuard() { EpochReclaimer::instance().exit(); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// Defer `delete ptr` until no reader can hold it
+template <typename T>
+void epoch_retire(T* ptr) {
+    EpochReclaimer::instance().retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <initializer_list>
+#include <cassert>
+#include <cstdint>
+#include "epoch_reclaim.hpp"
+#include "object_pool.hpp"
+
+// Lock-free multi-word CAS (Harris, Fraser & Pratt, "A Practical Multi-Word
+// Compare-and-Swap Operation", 2002)
+// 03_atomic_broken.cpp ends with "if multiple variables must change
+// together, you want a mutex". k-CAS changes up to MAX_WORDS words at once
+// without one:
+//
+//     KCasWord x, y;
+//     uint64_t vx = kcas_read(x), vy = kcas_read(y);
+//     kcas({{&x, vx, vx + 1}, {&y, vy, vy + 1}});   // both or neither
+//
+// Phase 1 installs a pointer to the operation's descriptor in every word,
+//         in address order, each with RDCSS ("CAS the word only while the
+//         descriptor is still UNDECIDED"), then decides SUCCEEDED/FAILED
+// Phase 2 replaces each descriptor with the new (or old) value
+// Anyone who meets a descriptor helps finish it first, so a stalled thread
+// never blocks the others. The two low bits of every word tag descriptors,
+// so values are limited to 62 bits. Descriptors are pool-allocated and
+// freed through EBR.
+
+class KCasWord {
+public:
+    explicit KCasWord(uint64_t v = 0) : raw(v << 2) {}
+
+private:
+    friend struct KCasImpl;
+    std::atomic<uint64_t> raw;
+};
+
+struct KCasEntry {
+    KCasWord* word;
+    uint64_t expected;
+    uint64_t desired;
+};
+
+struct KCasImpl {
+    static constexpr int MAX_WORDS = 8;
+    static constexpr uint64_t RDCSS_TAG = 1;
+    static constexpr uint64_t MCAS_TAG = 2;
+    static constexpr uint64_t TAG_MASK = 3;
+
+    enum Status : int { UNDECIDED, SUCCEEDED, FAILED };
+
+    struct Entry {
+        std::atomic<uint64_t>* addr;
+        uint64_t expected;  // Encoded (value << 2)
+        uint64_t desired;
+    };
+
+    struct McasDescriptor : PoolAllocated {
+        std::atomic<int> status{UNDECIDED};
+        int count = 0;
+        Entry entries[MAX_WORDS];
+    };
+
+    // "If *status == UNDECIDED then CAS(*addr, expected, mcas-descriptor)"
+    struct RdcssDescriptor : PoolAllocated {
+        McasDescriptor* owner;
+        std::atomic<uint64_t>* addr;
+        uint64_t expected;
+
+        RdcssDescriptor(McasDescriptor* o, std::atomic<uint64_t>* a, uint64_t e)
+            : owner(o), addr(a), expected(e) {}
+    };
+
+    static bool is_rdcss(uint64_t v) { return (v & TAG_MASK) == RDCSS_TAG; }
+    static bool is_mcas(uint64_t v) { return (v & TAG_MASK) == MCAS_TAG; }
+    static uint64_t tag(const void* d, uint64_t t) { return reinterpret_cast<uint64_t>(d) | t; }
+    template <typename D>
+    static D* untag(uint64_t v) { return reinterpret_cast<D*>(v & ~TAG_MASK); }
+
+    static std::atomic<uint64_t>& raw(KCasWord& w) { return w.raw; }
+
+    static void rdcss_complete(RdcssDescriptor* d) {
+        const bool undecided = d->owner->status.load(std::memory_order_acquire) == UNDECIDED;
+        uint64_t cur = tag(d, RDCSS_TAG);
+        d->addr->compare_exchange_strong(cur, undecided ? tag(d->owner, MCAS_TAG) : d->expected,
+                                         std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    // Returns the value found in the word (== expected on success)
+    static uint64_t rdcss(RdcssDescriptor* d) {
+        uint64_t cur;
+        while (true) {
+            cur = d->expected;
+            if (d->addr->compare_exchange_strong(cur, tag(d, RDCSS_TAG), std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                rdcss_complete(d);
+                return d->expected;
+            }
+            if (!is_rdcss(cur)) return cur;
+            rdcss_complete(untag<RdcssDescriptor>(cur));  // Someone else's: finish it
+        }
+    }
+
+    static uint64_t rdcss_read(std::atomic<uint64_t>& addr) {
+        while (true) {
+            uint64_t v = addr.load(std::memory_order_acquire);
+            if (!is_rdcss(v)) return v;
+            rdcss_complete(untag<RdcssDescriptor>(v));
+        }
+    }
+
+    // Run (or help) an operation to completion; caller holds an EpochGuard
+    static bool mcas(McasDescriptor* d) {
+        if (d->status.load(std::memory_order_acquire) == UNDECIDED) {
+            int outcome = SUCCEEDED;
+            for (int i = 0; i < d->count && outcome == SUCCEEDED; ++i) {
+                const Entry& e = d->entries[i];
+                while (true) {
+                    RdcssDescriptor* r = new RdcssDescriptor(d, e.addr, e.expected);
+                    const uint64_t v = rdcss(r);
+                    epoch_retire(r);
+                    if (is_mcas(v)) {
+                        McasDescriptor* other = untag<McasDescriptor>(v);
+                        if (other == d) break;  // A helper already installed us here
+                        mcas(other);
+                        continue;
+                    }
+                    if (v != e.expected) outcome = FAILED;
+                    break;
+                }
+            }
+            int undecided = UNDECIDED;
+            d->status.compare_exchange_strong(undecided, outcome, std::memory_order_acq_rel);
+        }
+        const bool ok = d->status.load(std::memory_order_acquire) == SUCCEEDED;
+        for (int i = 0; i < d->count; ++i) {
+            uint64_t cur = tag(d, MCAS_TAG);
+            d->entries[i].addr->compare_exchange_strong(
+                cur, ok ? d->entries[i].desired : d->entries[i].expected,
+                std::memory_order_acq_rel, std::memory_order_relaxed);
+        }
+        return ok;
+    }
+};
+
+// Current value of a word, helping any operation in flight on it
+inline uint64_t kcas_read(KCasWord& w) {
+    using A = KCasImpl;
+    EpochGuard guard;
+    while (true) {
+        const uint64_t v = A::rdcss_read(A::raw(w));
+        if (!A::is_mcas(v)) return v >> 2;
+        A::mcas(A::untag<A::McasDescriptor>(v));
+    }
+}
+
+// Atomically: if every word holds its expected value, store every desired
+// value. Words must be distinct; values must fit in 62 bits.
+inline bool kcas(const KCasEntry* entries, int count) {
+    using A = KCasImpl;
+    assert(count > 0 && count <= A::MAX_WORDS);
+    EpochGuard guard;
+    auto* d = new A::McasDescriptor;
+    d->count = count;
+    for (int i = 0; i < count; ++i)
+        d->entries[i] = {&A::raw(*entries[i].word), entries[i].expected << 2, entries[i].desired << 2};
+    // One global order so two operations never wait on each other in a cycle
+    std::sort(d->entries, d->entries + count,
+              [](const A::Entry& a, const A::Entry& b) { return a.addr < b.addr; });
+    const bool ok = A::mcas(d);
+    epoch_retire(d);
+    return ok;
+}
+
+inline bool kcas(std::initializer_list<KCasEntry> entries) {
+    return kcas(entries.begin(), static_cast<int>(entries.size()));
+}
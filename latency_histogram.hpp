@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// Lock-free log-linear latency histogram
+// Buckets are log-linear: 2^SUB_BITS linear sub-buckets per power of two, so
+// any value is kept to within 1/2^SUB_BITS (~3%) over the whole uint64 range
+// in a fixed 1920 buckets. Recording is a relaxed fetch_add into a STRIPE
+// of buckets; threads are spread round-robin over up to MAX_STRIPES stripes
+// (allocated on first use), so with <= MAX_STRIPES threads nobody shares a
+// line. snapshot() sums the stripes without stopping the writers.
+//
+//     LatencyHistogram hist;                   // shared by all workers
+//     hist.record(read_tsc() - t0);            // hot path: ~2 relaxed RMWs
+//     HistogramSnapshot s = hist.snapshot();   // any time, any thread
+//     s.percentile(99.9);
+//
+// The unit is the caller's (ns, TSC ticks, bytes...).
+
+class HistogramSnapshot {
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr int SUB = 1 << SUB_BITS;
+    static constexpr int BUCKETS = (65 - SUB_BITS) * SUB;
+
+    static int bucket(uint64_t v) {
+        if (v < SUB) return static_cast<int>(v);
+        const int e = 63 - __builtin_clzll(v);  // >= SUB_BITS
+        return (e - SUB_BITS + 1) * SUB + static_cast<int>((v >> (e - SUB_BITS)) - SUB);
+    }
+
+    static uint64_t bucket_low(int i) {
+        if (i < SUB) return static_cast<uint64_t>(i);
+        const int e = i / SUB + SUB_BITS - 1;
+        return static_cast<uint64_t>(i % SUB + SUB) << (e - SUB_BITS);
+    }
+
+    static uint64_t bucket_high(int i) {
+        return i + 1 < BUCKETS ? bucket_low(i + 1) - 1 : UINT64_MAX;
+    }
+
+    HistogramSnapshot() : counts(BUCKETS, 0) {}
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return largest; }
+    double mean() const { return total ? static_cast<double>(sum) / total : 0.0; }
+
+    // Smallest bucket bound with at least p% of samples at or below it
+    // (capped at the largest recorded value); p in [0, 100]
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * total + 0.5);
+        rank = std::max<uint64_t>(1, std::min(rank, total));
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(bucket_high(i), largest);
+        }
+        return largest;
+    }
+
+    // Combine with another histogram's snapshot (e.g. per-phase histograms)
+    void merge(const HistogramSnapshot& o) {
+        for (int i = 0; i < BUCKETS; ++i) counts[i] += o.counts[i];
+        total += o.total;
+        sum += o.sum;
+        largest = std::max(largest, o.largest);
+    }
+
+private:
+    friend class LatencyHistogram;
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t largest = 0;
+};
+
+class LatencyHistogram {
+public:
+    static constexpr int MAX_STRIPES = 64;
+
+    LatencyHistogram() = default;
+    ~LatencyHistogram() {
+        for (auto& s : stripes) delete s.load(std::memory_order_relaxed);
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t value) {
+        Stripe& s = local_stripe();
+        s.counts[HistogramSnapshot::bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        s.sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t m = s.largest.load(std::memory_order_relaxed);
+        while (value > m && !s.largest.compare_exchange_weak(m, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Not a point-in-time cut across buckets (writers keep going), but every
+    // count it sees was really recorded
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot out;
+        for (const auto& slot : stripes) {
+            const Stripe* s = slot.load(std::memory_order_acquire);
+            if (!s) continue;
+            for (int i = 0; i < HistogramSnapshot::BUCKETS; ++i) {
+                const uint64_t c = s->counts[i].load(std::memory_order_relaxed);
+                out.counts[i] += c;
+                out.total += c;
+            }
+            out.sum += s->sum.load(std::memory_order_relaxed);
+            out.largest = std::max(out.largest, s->largest.load(std::memory_order_relaxed));
+        }
+        return out;
+    }
+
+private:
+    struct alignas(64) Stripe {
+        std::atomic<uint64_t> counts[HistogramSnapshot::BUCKETS] = {};
+        alignas(64) std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> largest{0};
+    };
+
+    std::atomic<Stripe*> stripes[MAX_STRIPES] = {};
+
+    static int thread_index() {
+        static std::atomic<int> next{0};
+        thread_local int index = next.fetch_add(1, std::memory_order_relaxed) % MAX_STRIPES;
+        return index;
+    }
+
+    Stripe& local_stripe() {
+        std::atomic<Stripe*>& slot = stripes[thread_index()];
+        Stripe* s = slot.load(std::memory_order_acquire);
+        if (s) return *s;
+        // First record from this stripe: allocate, or take the racing winner's
+        Stripe* fresh = new Stripe;
+        if (slot.compare_exchange_strong(s, fresh, std::memory_order_acq_rel))
+            return *fresh;
+        delete fresh;
+        return *s;
+    }
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <utility>
+#include <exception>
+#include "backoff.hpp"
+#include "asymmetric_fence.hpp"
+
+// Left-Right (Ramalhete & Correia): wait-free reads of ANY structure
+// RCU (rcu.hpp) needs a new copy per update; Left-Right keeps exactly TWO
+// instances of an ordinary single-threaded structure (std::unordered_map,
+// a struct of several fields...) and lets readers use one while the writer
+// edits the other:
+//
+//     LeftRight<std::unordered_map<int, int>> map;
+//     int v = map.read([&](const auto& m) { return m.at(key); });  // wait-free
+//     map.modify([&](auto& m) { m[key] = 42; });                    // blocking
+//
+// Writer (one at a time, under a mutex):
+//   1. apply op to the instance readers are NOT using
+//   2. flip `left_right` so new readers go there
+//   3. flip `version` and wait until both read indicators have drained, so
+//      no reader is still inside the old instance
+//   4. apply the same op to the old instance (now private)
+// `op` runs twice, so it must be deterministic and must not move state out.
+// Readers: bump their own counter in the current version's indicator,
+// light_fence(), read, decrement - no loop, no RMW, never waits for a writer.
+
+// Process-wide reader slot per thread, shared by every LeftRight instance
+class LeftRightThreads {
+public:
+    static constexpr int MAX_THREADS = 256;
+
+    static int index() {
+        thread_local Holder holder;
+        return holder.index;
+    }
+
+    static int high_water() { return instance().hw.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<bool> in_use[MAX_THREADS] = {};
+    std::atomic<int> hw{0};  // Slots [0, hw) may be in use
+
+    static LeftRightThreads& instance() {
+        static LeftRightThreads threads;
+        return threads;
+    }
+
+    struct Holder {
+        int index = instance().acquire();
+        ~Holder() { instance().in_use[index].store(false, std::memory_order_release); }
+    };
+
+    int acquire() {
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            bool expected = false;
+            if (!in_use[i].load(std::memory_order_relaxed) &&
+                in_use[i].compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                int h = hw.load(std::memory_order_relaxed);
+                while (h < i + 1 && !hw.compare_exchange_weak(h, i + 1, std::memory_order_acq_rel)) {
+                }
+                return i;
+            }
+        }
+        std::terminate();  // More than MAX_THREADS live threads
+    }
+};
+
+template <typename T>
+class LeftRight {
+public:
+    template <typename... Args>
+    explicit LeftRight(const Args&... args) : instances{T(args...), T(args...)} {}
+
+    LeftRight(const LeftRight&) = delete;
+    LeftRight& operator=(const LeftRight&) = delete;
+
+    // fn(const T&) - must not call modify() on the same object
+    template <typename F>
+    auto read(F&& fn) const {
+        Indicator& mine = indicators[LeftRightThreads::index()];
+        const int vi = version.load(std::memory_order_acquire);
+        std::atomic<long>& count = mine.readers[vi];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        light_fence();  // Arrival visible before we pick an instance
+        struct Depart {
+            std::atomic<long>& c;
+            ~Depart() { c.store(c.load(std::memory_order_relaxed) - 1, std::memory_order_release); }
+        } depart{count};
+        return fn(instances[left_right.load(std::memory_order_acquire)]);
+    }
+
+    // fn(T&), applied to both instances in turn
+    template <typename F>
+    void modify(F&& fn) {
+        std::lock_guard<std::mutex> lock(writer);
+        const int lr = left_right.load(std::memory_order_relaxed);
+        fn(instances[1 - lr]);
+        left_right.store(1 - lr, std::memory_order_release);
+
+        const int prev = version.load(std::memory_order_relaxed);
+        heavy_fence();  // Pairs with light_fence(): late arrivals see the new side
+        wait_empty(1 - prev);
+        version.store(1 - prev, std::memory_order_release);
+        heavy_fence();
+        wait_empty(prev);
+
+        fn(instances[lr]);  // No reader can be here any more
+    }
+
+private:
+    struct alignas(64) Indicator {
+        std::atomic<long> readers[2] = {};  // Written only by the owning thread
+    };
+
+    T instances[2];
+    alignas(64) std::atomic<int> left_right{0};  // Instance readers use
+    alignas(64) std::atomic<int> version{0};     // Indicator new readers join
+    std::mutex writer;
+    mutable Indicator indicators[LeftRightThreads::MAX_THREADS];
+
+    void wait_empty(int vi) const {
+        const int n = LeftRightThreads::high_water();
+        for (int i = 0; i < n; ++i) {
+            int spins = 0;
+            while (indicators[i].readers[vi].load(std::memory_order_acquire) != 0) {
+                if (++spins < 64) cpu_relax();
+                else std::this_thread::yield();
+            }
+        }
+    }
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define OBJECT_POOL_HAVE_MMAP 1
+#else
+#define OBJECT_POOL_HAVE_MMAP 0
+#endif
+
+// Lock-free size-class object pool
+// Every `new Node` in the lock-free examples goes through malloc, which is a
+// shared structure of its own. This pool keeps the common path thread-local:
+//   - size classes 16, 32, ..., 512 bytes
+//   - each thread owns a heap with one plain free list per class
+//   - objects live in 64 KiB slabs (carved from mmap'd 4 MiB arenas); the
+//     slab header, found by masking the address, names the owning heap
+//   - freeing another thread's object pushes it onto the owner's per-class
+//     MPSC list (one CAS); the owner takes the whole list with one exchange
+//     when its local list runs dry
+//   - a heap outlives its thread: it is parked on an abandoned list and
+//     adopted by the next new thread, remote lists included
+//
+// Plug into any node type:
+//     struct Node : PoolAllocated { int data; Node* next; };
+// Memory is never returned to the OS; slabs are reused through the free lists.
+
+class ObjectPool {
+public:
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+    static constexpr size_t ARENA_SIZE = 4 * 1024 * 1024;
+    static constexpr size_t HEADER_SIZE = 64;
+    static constexpr int NUM_CLASSES = 6;
+    static constexpr size_t MAX_SIZE = size_t(16) << (NUM_CLASSES - 1);  // 512
+
+    static constexpr int size_class(size_t size) {
+        return size <= 16 ? 0 : (64 - __builtin_clzll(size - 1)) - 4;
+    }
+    static constexpr size_t class_size(int c) { return size_t(16) << c; }
+
+    // size must be <= MAX_SIZE
+    static void* allocate(size_t size) {
+        const int c = size_class(size);
+        ThreadHeap* h = local_heap();
+        FreeNode* n = h->local[c];
+        if (n) {
+            h->local[c] = n->next;
+            return n;
+        }
+        return h->refill(c);
+    }
+
+    static void deallocate(void* p) {
+        SlabHeader* slab = header_of(p);
+        FreeNode* n = static_cast<FreeNode*>(p);
+        if (slab->owner == tls_heap) {
+            n->next = tls_heap->local[slab->size_class];
+            tls_heap->local[slab->size_class] = n;
+        } else {
+            slab->owner->remote[slab->size_class].push(n);
+        }
+    }
+
+    // Slabs mapped so far (all threads)
+    static size_t slabs_in_use() { return source().slab_count.load(std::memory_order_relaxed); }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    // Multi-producer push, single-consumer take-all (no ABA: nobody pops one)
+    struct alignas(64) RemoteList {
+        std::atomic<FreeNode*> head{nullptr};
+
+        void push(FreeNode* n) {
+            FreeNode* old = head.load(std::memory_order_relaxed);
+            do {
+                n->next = old;
+            } while (!head.compare_exchange_weak(old, n, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        }
+
+        FreeNode* take_all() {
+            if (head.load(std::memory_order_relaxed) == nullptr) return nullptr;
+            return head.exchange(nullptr, std::memory_order_acquire);
+        }
+    };
+
+    struct ThreadHeap;
+
+    struct alignas(64) SlabHeader {
+        ThreadHeap* owner;
+        int size_class;
+    };
+    static_assert(sizeof(SlabHeader) <= HEADER_SIZE, "objects start after the header");
+
+    struct ThreadHeap {
+        FreeNode* local[NUM_CLASSES] = {};  // Owner only
+        RemoteList remote[NUM_CLASSES];     // Frees from other threads
+
+        void* refill(int c) {
+            if (FreeNode* list = remote[c].take_all()) {
+                local[c] = list->next;
+                return list;
+            }
+            // Carve a fresh slab: link every object but the first into local[c]
+            char* base = static_cast<char*>(source().get_slab());
+            new (base) SlabHeader{this, c};
+            const size_t sz = class_size(c);
+            const size_t count = (SLAB_SIZE - HEADER_SIZE) / sz;
+            char* first = base + HEADER_SIZE;
+            FreeNode* head = nullptr;
+            for (size_t i = count - 1; i > 0; --i) {
+                FreeNode* n = reinterpret_cast<FreeNode*>(first + i * sz);
+                n->next = head;
+                head = n;
+            }
+            local[c] = head;
+            return first;
+        }
+    };
+
+    // Global slab supply: the only lock, taken once per 64 KiB slab
+    struct SlabSource {
+        std::mutex mtx;
+        char* cursor = nullptr;
+        char* limit = nullptr;
+        std::atomic<size_t> slab_count{0};
+        std::vector<ThreadHeap*> abandoned;
+
+        void* get_slab() {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (cursor == limit) {
+                cursor = static_cast<char*>(map_arena());
+                limit = cursor + ARENA_SIZE;
+            }
+            void* slab = cursor;
+            cursor += SLAB_SIZE;
+            slab_count.fetch_add(1, std::memory_order_relaxed);
+            return slab;
+        }
+
+        // ARENA_SIZE bytes aligned to SLAB_SIZE, so header_of() can mask
+        static void* map_arena() {
+#if OBJECT_POOL_HAVE_MMAP
+            const size_t len = ARENA_SIZE + SLAB_SIZE;
+            void* raw = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) throw std::bad_alloc();
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (start + SLAB_SIZE - 1) & ~(uintptr_t(SLAB_SIZE) - 1);
+            if (aligned > start) munmap(raw, aligned - start);
+            uintptr_t tail = aligned + ARENA_SIZE;
+            if (tail < start + len) munmap(reinterpret_cast<void*>(tail), start + len - tail);
+            return reinterpret_cast<void*>(aligned);
+#else
+            void* p = std::aligned_alloc(SLAB_SIZE, ARENA_SIZE);
+            if (!p) throw std::bad_alloc();
+            return p;
+#endif
+        }
+    };
+
+    static SlabSource& source() {
+        static SlabSource* s = new SlabSource;  // Never destroyed: frees may run at exit
+        return *s;
+    }
+
+    static SlabHeader* header_of(void* p) {
+        return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(p) &
+                                             ~(uintptr_t(SLAB_SIZE) - 1));
+    }
+
+    // Hands the heap to the next thread when this one exits
+    struct HeapGuard {
+        ~HeapGuard() {
+            if (!tls_heap) return;
+            SlabSource& s = source();
+            std::lock_guard<std::mutex> lock(s.mtx);
+            s.abandoned.push_back(tls_heap);
+            tls_heap = nullptr;  // Later frees on this thread go the remote path
+        }
+    };
+
+    static inline thread_local ThreadHeap* tls_heap = nullptr;
+
+    static ThreadHeap* local_heap() {
+        if (tls_heap) return tls_heap;
+        thread_local HeapGuard guard;
+        SlabSource& s = source();
+        {
+            std::lock_guard<std::mutex> lock(s.mtx);
+            if (!s.abandoned.empty()) {
+                tls_heap = s.abandoned.back();
+                s.abandoned.pop_back();
+            }
+        }
+        if (!tls_heap) tls_heap = new ThreadHeap;
+        return tls_heap;
+    }
+};
+
+// Mixin: class-specific operator new/delete routed through ObjectPool.
+// Oversized derived types fall back to the global heap.
+struct PoolAllocated {
+    static void* operator new(size_t size) {
+        return size <= ObjectPool::MAX_SIZE ? ObjectPool::allocate(size) : ::operator new(size);
+    }
+
+    static void operator delete(void* p, size_t size) {
+        if (!p) return;
+        if (size <= ObjectPool::MAX_SIZE) ObjectPool::deallocate(p);
+        else ::operator delete(p);
+    }
+};
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <exception>
+#include "backoff.hpp"
+#include "asymmetric_fence.hpp"
+
+// Userspace RCU (read-copy-update)
+// 03_atomic_broken.cpp shows that two atomics don't make an atomic pair.
+// RCU's answer for read-mostly data: never modify shared state in place.
+// A writer copies the object, edits the copy, publishes it with one pointer
+// store, and frees the old copy only after a GRACE PERIOD - once every reader
+// that might still be looking at it has left its read-side section.
+//
+//     rcu_pointer<Config> config;
+//     {                                       // reader: no RMW, no lock
+//         RcuReadGuard guard;
+//         const Config* c = config.load();    // consistent x and y
+//     }
+//     Config* old = config.exchange(new Config{...});   // writer
+//     call_rcu(old);            // or: synchronize_rcu(); delete old;
+//
+// Grace periods use one global 64-bit counter. A reader publishes the value
+// it saw on entry in its own slot; an object unlinked when the counter was
+// bumped to g is safe once every active slot is >= g.
+
+class RcuDomain {
+public:
+    static constexpr int MAX_THREADS = 256;
+    static constexpr uint64_t OFFLINE = 0;  // Slot value outside read sections
+    static constexpr size_t DEFER_THRESHOLD = 64;
+
+    static RcuDomain& instance() {
+        static RcuDomain domain;
+        return domain;
+    }
+
+    void read_lock() {
+        ThreadState& ts = local();
+        if (ts.depth++ == 0) {
+            ts.slot->value.store(gp_counter.load(std::memory_order_acquire),
+                                 std::memory_order_relaxed);
+            // Slot store before any protected load (pairs with heavy_fence())
+            light_fence();
+        }
+    }
+
+    void read_unlock() {
+        ThreadState& ts = local();
+        if (--ts.depth == 0)
+            ts.slot->value.store(OFFLINE, std::memory_order_release);
+    }
+
+    // Blocks until every read section that started before the call has ended.
+    // Must not be called inside a read section (it would wait for itself).
+    void synchronize() {
+        const uint64_t target = gp_counter.fetch_add(1, std::memory_order_seq_cst) + 1;
+        wait_for_readers(target);
+    }
+
+    // Frees `ptr` after a grace period, without blocking the caller (except
+    // when a long-running reader lets DEFER_THRESHOLD callbacks pile up)
+    void defer(void* ptr, void (*deleter)(void*)) {
+        ThreadState& ts = local();
+        const uint64_t g = gp_counter.fetch_add(1, std::memory_order_seq_cst) + 1;
+        ts.deferred.push_back({ptr, deleter, g});
+        if (ts.deferred.size() >= DEFER_THRESHOLD) {
+            poll(ts.deferred);
+            if (ts.deferred.size() >= DEFER_THRESHOLD && ts.depth == 0)
+                drain(ts.deferred);  // Still full: wait it out once
+        }
+    }
+
+    size_t pending() { return local().deferred.size(); }
+
+private:
+    struct Deferred {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t gp;  // Counter value after the unlink
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> value{OFFLINE};
+        std::atomic<bool> in_use{false};
+    };
+
+    struct ThreadState {
+        Slot* slot = nullptr;
+        int depth = 0;
+        std::vector<Deferred> deferred;
+
+        ~ThreadState() {
+            if (!slot) return;
+            instance().drain(deferred);
+            slot->value.store(OFFLINE, std::memory_order_release);
+            slot->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    alignas(64) std::atomic<uint64_t> gp_counter{1};
+    alignas(64) std::atomic<int> high_water{0};
+    Slot slots[MAX_THREADS];
+
+    ThreadState& local() {
+        thread_local ThreadState ts;
+        if (!ts.slot) ts.slot = acquire_slot();
+        return ts;
+    }
+
+    Slot* acquire_slot() {
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            bool expected = false;
+            if (!slots[i].in_use.load(std::memory_order_relaxed) &&
+                slots[i].in_use.compare_exchange_strong(expected, true,
+                                                        std::memory_order_acq_rel)) {
+                int hw = high_water.load(std::memory_order_relaxed);
+                while (hw < i + 1 &&
+                       !high_water.compare_exchange_weak(hw, i + 1, std::memory_order_acq_rel)) {
+                }
+                return &slots[i];
+            }
+        }
+        std::terminate();  // More than MAX_THREADS live threads
+    }
+
+    // Oldest counter value any active reader entered with (~0 if none).
+    // Callers issue one heavy_fence() first: a reader that enters after it
+    // already sees the unlinked state, so rescans need no further fence.
+    uint64_t oldest_reader() {
+        uint64_t oldest = ~0ull;
+        const int n = high_water.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i) {
+            uint64_t v = slots[i].value.load(std::memory_order_acquire);
+            if (v != OFFLINE && v < oldest) oldest = v;
+        }
+        return oldest;
+    }
+
+    void wait_for_readers(uint64_t target) {
+        heavy_fence();
+        int spins = 0;
+        while (oldest_reader() < target) {
+            if (++spins < 64) cpu_relax();
+            else std::this_thread::yield();
+        }
+    }
+
+    void poll(std::vector<Deferred>& list) {
+        heavy_fence();
+        const uint64_t oldest = oldest_reader();
+        size_t kept = 0;
+        for (auto& d : list) {
+            if (d.gp <= oldest)
+                d.deleter(d.ptr);
+            else
+                list[kept++] = d;
+        }
+        list.resize(kept);
+    }
+
+    void drain(std::vector<Deferred>& list) {
+        if (list.empty()) return;
+        wait_for_readers(list.back().gp);  // Newest entry covers all older ones
+        for (auto& d : list) d.deleter(d.ptr);
+        list.clear();
+    }
+};
+
+inline void rcu_read_lock() { RcuDomain::instance().read_lock(); }
+inline void rcu_read_unlock() { RcuDomain::instance().read_unlock(); }
+inline void synchronize_rcu() { RcuDomain::instance().synchronize(); }
+
+template <typename T>
+void call_rcu(T* ptr) {
+    RcuDomain::instance().defer(ptr, [](void* p) { delete static_cast<T*>(p); });
+}
+
+struct RcuReadGuard {
+    RcuReadGuard() { rcu_read_lock(); }
+    ~RcuReadGuard() { rcu_read_unlock(); }
+    RcuReadGuard(const RcuReadGuard&) = delete;
+    RcuReadGuard& operator=(const RcuReadGuard&) = delete;
+};
+
+// RCU-protected pointer: load() inside a read section, exchange() to publish
+template <typename T>
+class rcu_pointer {
+public:
+    rcu_pointer(T* initial = nullptr) : ptr(initial) {}
+    rcu_pointer(const rcu_pointer&) = delete;
+    rcu_pointer& operator=(const rcu_pointer&) = delete;
+
+    // Reader: valid until the enclosing read section ends
+    T* load() const { return ptr.load(std::memory_order_acquire); }
+
+    // Writer: publish a fully initialized object, get the old one back
+    T* exchange(T* desired) { return ptr.exchange(desired, std::memory_order_acq_rel); }
+
+    // Writer: for concurrent writers without an external lock
+    bool compare_exchange(T*& expected, T* desired) {
+        return ptr.compare_exchange_strong(expected, desired, std::memory_order_acq_rel,
+                                           std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<T*> ptr;
+};
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include "backoff.hpp"
+#include "chase_lev_deque.hpp"
+#include "zipf.hpp"
+
+// Work-stealing thread pool
+// Every example used to create and join fresh std::threads per run (tens of
+// microseconds each). Here workers are created once and tasks go through the
+// Chase-Lev deques from chase_lev_deque.hpp:
+//   - a worker pushes the tasks it spawns onto its OWN deque (no lock)
+//   - an idle worker steals from randomly chosen victims
+//   - threads outside the pool submit through one mutex-protected queue
+//   - workers that find nothing spin briefly, then park on a condvar
+//
+//     ThreadPool pool;                              // hardware_concurrency workers
+//     pool.parallel_for(0, n, 1024, [&](int64_t i) { out[i] = f(in[i]); });
+//     pool.submit([] { ... });  pool.wait_idle();
+
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned num_workers = std::thread::hardware_concurrency()) {
+        if (num_workers == 0) num_workers = 1;
+        for (unsigned i = 0; i < num_workers; ++i)
+            workers.emplace_back(new Worker(i + 1));
+        for (unsigned i = 0; i < num_workers; ++i)
+            workers[i]->thread = std::thread(&ThreadPool::worker_loop, this, i);
+    }
+
+    ~ThreadPool() {
+        wait_idle();
+        {
+            std::lock_guard<std::mutex> lock(park_mutex);
+            stopping.store(true, std::memory_order_release);
+        }
+        park_cv.notify_all();
+        for (auto& w : workers)
+            w->thread.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Fire and forget; use wait_idle() or parallel_for() to join
+    template <typename F>
+    void submit(F&& f) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        Task* task = new Task(std::forward<F>(f));
+        if (tls_pool == this) {
+            workers[tls_index]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(inject_mutex);
+            injected.push_back(task);
+            injected_size.fetch_add(1, std::memory_order_relaxed);
+        }
+        wake_one();
+    }
+
+    // Blocks until every submitted task has finished. The caller helps run
+    // tasks while it waits, so it is safe to call from inside a task.
+    void wait_idle() {
+        int spins = 0;
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (help_one()) spins = 0;
+            else if (++spins < 64) cpu_relax();
+            else std::this_thread::yield();
+        }
+    }
+
+    // Runs fn(i) for every i in [begin, end). Ranges larger than `grain` are
+    // split in half recursively; the halves are spawned as tasks and stolen
+    // by idle workers, so the load balances itself.
+    template <typename F>
+    void parallel_for(int64_t begin, int64_t end, int64_t grain, F&& fn) {
+        if (begin >= end) return;
+        ForState<F> state{fn, grain < 1 ? 1 : grain, {end - begin}, this};
+        if (tls_pool == this)
+            split(&state, begin, end);
+        else
+            submit([&state, begin, end] { split(&state, begin, end); });
+
+        int spins = 0;
+        while (state.remaining.load(std::memory_order_acquire) != 0) {
+            if (help_one()) spins = 0;
+            else if (++spins < 64) cpu_relax();
+            else std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Worker {
+        ChaseLevDeque<Task*> deque;
+        FastRandom rng;
+        std::thread thread;
+        explicit Worker(uint64_t seed) : rng(seed) {}
+    };
+
+    template <typename F>
+    struct ForState {
+        F& fn;
+        int64_t grain;
+        std::atomic<int64_t> remaining;
+        ThreadPool* pool;
+    };
+
+    template <typename F>
+    static void split(ForState<F>* s, int64_t begin, int64_t end) {
+        while (end - begin > s->grain) {
+            const int64_t mid = begin + (end - begin) / 2;
+            s->pool->submit([s, mid, end] { split(s, mid, end); });
+            end = mid;
+        }
+        for (int64_t i = begin; i < end; ++i)
+            s->fn(i);
+        s->remaining.fetch_sub(end - begin, std::memory_order_release);  // Last touch of *s
+    }
+
+    static constexpr int SPIN_ROUNDS = 64;  // find_task() attempts before parking
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex inject_mutex;  // Submissions from threads outside the pool
+    std::deque<Task*> injected;
+    std::atomic<int64_t> injected_size{0};  // Lets workers skip the lock when empty
+
+    alignas(64) std::atomic<int64_t> pending{0};  // Submitted, not yet finished
+    alignas(64) std::atomic<int> sleepers{0};
+    std::atomic<uint64_t> wake_epoch{0};
+    std::atomic<bool> stopping{false};
+    std::mutex park_mutex;
+    std::condition_variable park_cv;
+
+    static inline thread_local ThreadPool* tls_pool = nullptr;
+    static inline thread_local unsigned tls_index = 0;
+
+    void run(Task* task) {
+        (*task)();
+        delete task;
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    Task* take_injected() {
+        std::lock_guard<std::mutex> lock(inject_mutex);
+        if (injected.empty()) return nullptr;
+        Task* t = injected.front();
+        injected.pop_front();
+        injected_size.fetch_sub(1, std::memory_order_relaxed);
+        return t;
+    }
+
+    // Random start, then sweep every victim once
+    Task* steal_from_others(unsigned self, FastRandom& rng) {
+        const unsigned n = static_cast<unsigned>(workers.size());
+        const unsigned start = static_cast<unsigned>(rng.next(n));
+        Task* t;
+        for (unsigned k = 0; k < n; ++k) {
+            unsigned v = (start + k) % n;
+            if (v == self) continue;
+            auto r = workers[v]->deque.steal(t);
+            while (r == ChaseLevDeque<Task*>::Steal::Lost)  // Still non-empty
+                r = workers[v]->deque.steal(t);
+            if (r == ChaseLevDeque<Task*>::Steal::Success) return t;
+        }
+        return nullptr;
+    }
+
+    Task* find_task(unsigned self) {
+        Task* t;
+        if (workers[self]->deque.pop(t)) return t;
+        if (injected_size.load(std::memory_order_seq_cst) != 0 && (t = take_injected()))
+            return t;
+        return steal_from_others(self, workers[self]->rng);
+    }
+
+    // Used by threads blocked in wait_idle()/parallel_for()
+    bool help_one() {
+        Task* t = nullptr;
+        if (tls_pool == this) {
+            t = find_task(tls_index);
+        } else {
+            thread_local FastRandom rng(0xC0FFEE);
+            t = take_injected();
+            if (!t) t = steal_from_others(static_cast<unsigned>(workers.size()), rng);
+        }
+        if (!t) return false;
+        run(t);
+        return true;
+    }
+
+    // Submitter side of the parking protocol: publish task, fence, read sleepers
+    void wake_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(park_mutex);
+            wake_epoch.fetch_add(1, std::memory_order_relaxed);
+        }
+        park_cv.notify_one();
+    }
+
+    void worker_loop(unsigned self) {
+        tls_pool = this;
+        tls_index = self;
+        int idle_rounds = 0;
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (Task* t = find_task(self)) {
+                run(t);
+                idle_rounds = 0;
+                continue;
+            }
+            if (++idle_rounds < SPIN_ROUNDS) {
+                cpu_relax();
+                continue;
+            }
+            // Park: announce, re-check (Dekker with wake_one), then sleep
+            const uint64_t epoch = wake_epoch.load(std::memory_order_acquire);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (Task* t = find_task(self)) {
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                run(t);
+                idle_rounds = 0;
+                continue;
+            }
+            {
+                std::unique_lock<std::mutex> lock(park_mutex);
+                park_cv.wait(lock, [&] {
+                    return wake_epoch.load(std::memory_order_relaxed) != epoch ||
+                           stopping.load(std::memory_order_relaxed);
+                });
+            }
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idle_rounds = 0;
+        }
+    }
+};
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <exception>
+#include <cstdio>
+#include <cstdint>
+#include "backoff.hpp"
+
+// Per-thread lossy trace rings for hot-path logging
+// trace() must be callable from inside a CAS retry loop, so it can't lock,
+// allocate, format or share a cache line with another thread. Each thread
+// owns one SPSC ring of fixed-size binary records:
+//
+//     trace("cas retry old=%llu spins=%llu", old, spins);   // ~a few ns
+//
+// The record holds the TSC, the format string POINTER and two integer
+// arguments. Formatting happens later, on the drainer thread. The producer
+// never waits: when the drainer falls behind, the oldest records are
+// overwritten and counted as lost.
+//
+//     TraceDrainer drainer(print_trace_to(stdout));   // background thread
+//     ...
+//     drainer.stop();                                  // final drain
+//
+// `fmt` must be a string literal (it is read after the call returns) whose
+// conversions take unsigned long long (%llu, %llx). Compile with
+// -DTRACE_ENABLED=0 to turn every trace() into a no-op.
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+struct TraceEvent {
+    uint64_t tsc;
+    int ring;  // Which thread slot produced it
+    const char* fmt;
+    unsigned long long a;
+    unsigned long long b;
+};
+
+// Deferred formatting: only ever called by the drainer
+inline int format_trace(const TraceEvent& e, char* buf, size_t size) {
+    return std::snprintf(buf, size, e.fmt, e.a, e.b);
+}
+
+class TraceRing {
+public:
+    static constexpr size_t RECORDS = 4096;  // Power of two, 32 bytes each
+    static constexpr size_t MASK = RECORDS - 1;
+
+    // Producer (owning thread) only
+    void push(const char* fmt, uint64_t a, uint64_t b) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        Record& r = records[h & MASK];
+        // The drainer must see head >= h before it can see record h's data
+        // replacing record h - RECORDS (a compiler barrier on x86)
+        std::atomic_thread_fence(std::memory_order_release);
+        r.tsc.store(read_tsc(), std::memory_order_relaxed);
+        r.fmt.store(fmt, std::memory_order_relaxed);
+        r.a.store(a, std::memory_order_relaxed);
+        r.b.store(b, std::memory_order_relaxed);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Consumer (drainer) only: append every intact record since the last
+    // call to `out`; returns how many were overwritten before we got to them
+    uint64_t drain(int ring_index, std::vector<TraceEvent>& out) {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        uint64_t t = tail;
+        uint64_t lost = 0;
+        if (h - t > RECORDS) {
+            lost += h - RECORDS - t;
+            t = h - RECORDS;
+        }
+        const size_t first = out.size();
+        for (uint64_t i = t; i < h; ++i) {
+            const Record& r = records[i & MASK];
+            out.push_back({r.tsc.load(std::memory_order_relaxed), ring_index,
+                           r.fmt.load(std::memory_order_relaxed),
+                           r.a.load(std::memory_order_relaxed),
+                           r.b.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Record i may have been overwritten while we copied it once the
+        // producer started record i + RECORDS, i.e. unless i > head - RECORDS
+        const uint64_t h2 = head.load(std::memory_order_relaxed);
+        if (h2 >= RECORDS && t <= h2 - RECORDS) {
+            const uint64_t torn = std::min(h, h2 - RECORDS + 1) - t;
+            out.erase(out.begin() + first, out.begin() + first + torn);
+            lost += torn;
+        }
+        tail = h;
+        return lost;
+    }
+
+private:
+    struct Record {
+        std::atomic<uint64_t> tsc{0};
+        std::atomic<const char*> fmt{nullptr};
+        std::atomic<unsigned long long> a{0};
+        std::atomic<unsigned long long> b{0};
+    };
+
+    alignas(64) std::atomic<uint64_t> head{0};  // Written by the producer only
+    alignas(64) uint64_t tail = 0;              // Drainer's private cursor
+    alignas(64) Record records[RECORDS];
+};
+
+// Owns one ring per thread slot; a thread takes a slot on its first trace()
+// and gives it back on exit (the next thread continues the same ring).
+class TraceRegistry {
+public:
+    static constexpr int MAX_THREADS = 256;
+
+    static TraceRegistry& instance() {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    TraceRing& local() {
+        thread_local TraceRing* ring = nullptr;
+        if (!ring) ring = acquire();
+        return *ring;
+    }
+
+    // Drainer side: rings [0, high_water) may hold records
+    int ring_count() const { return high_water.load(std::memory_order_acquire); }
+    TraceRing* ring(int i) const { return slots[i].ring.load(std::memory_order_acquire); }
+
+    ~TraceRegistry() {
+        for (auto& s : slots) delete s.ring.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<TraceRing*> ring{nullptr};
+        std::atomic<bool> in_use{false};
+    };
+
+    struct Releaser {
+        Slot* slot = nullptr;
+        ~Releaser() {
+            if (slot) slot->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    Slot slots[MAX_THREADS];
+    alignas(64) std::atomic<int> high_water{0};
+
+    // Cold path: first trace() on this thread
+    TraceRing* acquire() {
+        thread_local Releaser releaser;
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            bool expected = false;
+            if (!slots[i].in_use.load(std::memory_order_relaxed) &&
+                slots[i].in_use.compare_exchange_strong(expected, true,
+                                                        std::memory_order_acq_rel)) {
+                TraceRing* r = slots[i].ring.load(std::memory_order_acquire);
+                if (!r) {
+                    r = new TraceRing;
+                    slots[i].ring.store(r, std::memory_order_release);
+                }
+                int hw = high_water.load(std::memory_order_relaxed);
+                while (hw < i + 1 &&
+                       !high_water.compare_exchange_weak(hw, i + 1, std::memory_order_acq_rel)) {
+                }
+                releaser.slot = &slots[i];
+                return r;
+            }
+        }
+        std::terminate();  // More than MAX_THREADS live threads
+    }
+};
+
+inline void trace(const char* fmt, uint64_t a = 0, uint64_t b = 0) {
+#if TRACE_ENABLED
+    TraceRegistry::instance().local().push(fmt, a, b);
+#else
+    (void)fmt, (void)a, (void)b;
+#endif
+}
+
+// Background thread: periodically collects all rings, orders the batch by
+// TSC and hands each event to the sink (where formatting happens)
+class TraceDrainer {
+public:
+    using Sink = std::function<void(const TraceEvent&)>;
+
+    explicit TraceDrainer(Sink sink, std::chrono::microseconds interval = std::chrono::milliseconds(1))
+        : sink(std::move(sink)), interval(interval), worker([this] { run(); }) {}
+
+    ~TraceDrainer() { stop(); }
+
+    TraceDrainer(const TraceDrainer&) = delete;
+    TraceDrainer& operator=(const TraceDrainer&) = delete;
+
+    // Stops the thread after one last pass over every ring
+    void stop() {
+        if (!running.exchange(false)) return;
+        worker.join();
+        drain_once();
+    }
+
+    // Totals so far - read after stop() for exact numbers
+    uint64_t delivered() const { return delivered_count.load(std::memory_order_relaxed); }
+    uint64_t lost() const { return lost_count.load(std::memory_order_relaxed); }
+
+private:
+    Sink sink;
+    const std::chrono::microseconds interval;
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> delivered_count{0};
+    std::atomic<uint64_t> lost_count{0};
+    std::vector<TraceEvent> batch;
+    std::thread worker;  // Last member: starts after everything above exists
+
+    void run() {
+        while (running.load(std::memory_order_acquire)) {
+            drain_once();
+            std::this_thread::sleep_for(interval);
+        }
+    }
+
+    void drain_once() {
+        TraceRegistry& reg = TraceRegistry::instance();
+        batch.clear();
+        uint64_t lost = 0;
+        const int n = reg.ring_count();
+        for (int i = 0; i < n; ++i)
+            if (TraceRing* r = reg.ring(i)) lost += r->drain(i, batch);
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const TraceEvent& x, const TraceEvent& y) { return x.tsc < y.tsc; });
+        for (const TraceEvent& e : batch) sink(e);
+        delivered_count.fetch_add(batch.size(), std::memory_order_relaxed);
+        lost_count.fetch_add(lost, std::memory_order_relaxed);
+    }
+};
+
+// Sink that formats one line per event: "<tsc> [ring] message"
+inline TraceDrainer::Sink print_trace_to(FILE* out) {
+    return [out](const TraceEvent& e) {
+        char msg[256];
+        format_trace(e, msg, sizeof(msg));
+        std::fprintf(out, "%llu [%d] %s\n", static_cast<unsigned long long>(e.tsc), e.ring, msg);
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// Key generators for the data-structure benchmarks
+// Uniform keys spread load evenly; Zipfian keys concentrate it on a few hot
+// keys (real caches and indexes look like this), which is where contention
+// on individual nodes, buckets and cache lines shows up.
+
+// xorshift64*: fast per-thread PRNG, no shared state
+struct FastRandom {
+    uint64_t state;
+
+    explicit FastRandom(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull | 1) {}
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1Dull;
+    }
+
+    // Uniform in [0, n)
+    uint64_t next(uint64_t n) { return next() % n; }
+
+    // Uniform in [0, 1)
+    double next_double() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// Zipfian over [0, n) with skew theta (0.99 = YCSB default).
+// Gray et al., "Quickly Generating Billion-Record Synthetic Databases":
+// O(n) setup to compute zeta(n), then O(1) per sample.
+class ZipfGenerator {
+public:
+    ZipfGenerator(uint64_t n, double theta = 0.99)
+        : n(n), theta(theta) {
+        zeta_n = zeta(n, theta);
+        const double zeta_2 = zeta(2, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta_2 / zeta_n);
+        half_pow_theta = 1.0 + std::pow(0.5, theta);
+    }
+
+    // Rank 0 is the hottest key
+    uint64_t next(FastRandom& rng) const {
+        const double u = rng.next_double();
+        const double uz = u * zeta_n;
+        if (uz < 1.0) return 0;
+        if (uz < half_pow_theta) return 1;
+        uint64_t v = static_cast<uint64_t>(n * std::pow(eta * u - eta + 1.0, alpha));
+        return v < n ? v : n - 1;
+    }
+
+private:
+    uint64_t n;
+    double theta;
+    double zeta_n;
+    double alpha;
+    double eta;
+    double half_pow_theta;
+
+    static double zeta(uint64_t n, double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; ++i)
+            sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        return sum;
+    }
+};